@@ -0,0 +1,141 @@
+// File:  pwmFrequencySolverBenchmark.cpp
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  Compares PWMOutput::FindDivisorAndRange with the search that
+//        SetFrequency used previously (walking outward from the target
+//        divisor-range product and trial dividing each candidate), over a
+//        sweep of target frequencies.  Build from the repository root with:
+//        g++ -std=c++17 -O2 -pthread -I. benchmark/pwmFrequencySolverBenchmark.cpp
+//            pwmOutput.cpp gpio.cpp gpioBackend.cpp interrupt.cpp
+//            wiringPiGPIOBackend.cpp wiringPiPWMBackend.cpp -lwiringPi
+
+// Standard C/C++ headers
+#include <cmath>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <algorithm>
+
+// Local headers
+#include "pwmOutput.h"
+
+// Same limits as PWMOutput
+static const double pwmClockFrequency(19.2e6);// [Hz]
+static const unsigned int minClockDivisor(2);
+static const unsigned int maxClockDivisor(4095);
+static const unsigned int maxRange(4096);
+
+// The previous implementation, from PWMOutput::GetMinimumAcceptableFactor
+static unsigned int GetMinimumAcceptableFactor(unsigned int i)
+{
+	unsigned int f(1);
+	while (f++, (i % f != 0 || i / f > maxRange) && f <= maxClockDivisor) {}
+
+	return f;
+}
+
+// The previous implementation, from PWMOutput::SetFrequency
+static bool LegacyFindDivisorAndRange(const double& newFrequency, const unsigned int& minResolution,
+	unsigned int& divisor, unsigned int& newRange)
+{
+	const unsigned int rangeDivisorProduct = floor(pwmClockFrequency / newFrequency + 0.5);
+	divisor = 1;
+	newRange = 0;
+
+	if (rangeDivisorProduct / minResolution < minClockDivisor ||
+		rangeDivisorProduct / maxClockDivisor > maxRange)
+		return false;
+
+	unsigned int i(1);
+	while (divisor < 2 || newRange > maxRange ||
+		divisor > maxClockDivisor || newRange < minResolution)
+	{
+		if (i >= 2 * rangeDivisorProduct)
+			return false;
+
+		if (i % 2 == 0)
+			divisor = GetMinimumAcceptableFactor(rangeDivisorProduct + floor(i / 2.0));
+		else
+			divisor = GetMinimumAcceptableFactor(rangeDivisorProduct - floor(i / 2.0));
+		i++;
+
+		newRange = floor(rangeDivisorProduct / divisor + 0.5);
+	}
+
+	return true;
+}
+
+struct Result
+{
+	double totalTime = 0.0;// [usec]
+	double maxTime = 0.0;// [usec]
+	double maxError = 0.0;// [%]
+	unsigned int solved = 0;
+};
+
+typedef bool (*Solver)(const double&, const unsigned int&, unsigned int&, unsigned int&);
+
+static void Measure(Solver solver, const double& frequency, const unsigned int& minResolution,
+	const unsigned int& repetitions, Result& result)
+{
+	unsigned int divisor(0), range(0);
+	bool solved(false);
+
+	const auto start(std::chrono::steady_clock::now());
+	unsigned int i;
+	for (i = 0; i < repetitions; i++)
+		solved = solver(frequency, minResolution, divisor, range);
+	const double elapsed(std::chrono::duration<double, std::micro>(
+		std::chrono::steady_clock::now() - start).count() / repetitions);
+
+	result.totalTime += elapsed;
+	result.maxTime = std::max(result.maxTime, elapsed);
+	if (!solved)
+		return;
+
+	result.solved++;
+	const double achieved(pwmClockFrequency / divisor / range);
+	result.maxError = std::max(result.maxError, 100.0 * fabs(achieved - frequency) / frequency);
+}
+
+static void Report(const std::string& name, const Result& result, const unsigned int& count)
+{
+	std::cout << std::setw(10) << name << std::fixed << std::setprecision(2)
+		<< std::setw(12) << result.totalTime / count
+		<< std::setw(12) << result.maxTime
+		<< std::setw(12) << std::setprecision(4) << result.maxError
+		<< std::setw(8) << result.solved << std::endl;
+}
+
+int main(int, char*[])
+{
+	const unsigned int minResolution(100);
+	const unsigned int frequencyCount(500);
+	const unsigned int repetitions(5);
+
+	// Log-spaced from just above the lowest achievable frequency to just
+	// below the highest one at this resolution
+	const double lowFrequency(pwmClockFrequency / maxClockDivisor / maxRange * 1.01);
+	const double highFrequency(pwmClockFrequency / minClockDivisor / minResolution * 0.99);
+
+	Result previous, current;
+	unsigned int i;
+	for (i = 0; i < frequencyCount; i++)
+	{
+		const double frequency(lowFrequency * pow(highFrequency / lowFrequency,
+			static_cast<double>(i) / (frequencyCount - 1)));
+		Measure(LegacyFindDivisorAndRange, frequency, minResolution, repetitions, previous);
+		Measure(PWMOutput::FindDivisorAndRange, frequency, minResolution, repetitions, current);
+	}
+
+	std::cout << frequencyCount << " frequencies from " << lowFrequency << " to "
+		<< highFrequency << " Hz, minimum resolution " << minResolution << std::endl;
+	std::cout << std::setw(10) << "Solver" << std::setw(12) << "Mean [us]" << std::setw(12) << "Max [us]"
+		<< std::setw(12) << "Max err [%]" << std::setw(8) << "Solved" << std::endl;
+	Report("Previous", previous, frequencyCount);
+	Report("Current", current, frequencyCount);
+
+	return 0;
+}
@@ -0,0 +1,1017 @@
+// File:  characterDeviceGPIOBackend.cpp
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  GPIO backend built on the Linux GPIO character device (uAPI v2).
+//        Every line used through this backend belongs to a single line
+//        request, so any group of lines can be read or written with one
+//        ioctl and all edge events arrive (with kernel timestamps) on one
+//        file descriptor, serviced by one thread.
+
+// Standard C/C++ headers
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <map>
+#include <bitset>
+
+// *nix standard headers
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+// Local headers
+#include "characterDeviceGPIOBackend.h"
+
+//==========================================================================
+// Class:			CharacterDeviceGPIOBackend
+// Function:		Constant definitions
+//
+// Description:		Constant definitions for CharacterDeviceGPIOBackend class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const uint64_t CharacterDeviceGPIOBackend::biasFlags = GPIO_V2_LINE_FLAG_BIAS_PULL_UP |
+	GPIO_V2_LINE_FLAG_BIAS_PULL_DOWN | GPIO_V2_LINE_FLAG_BIAS_DISABLED;
+const uint64_t CharacterDeviceGPIOBackend::edgeFlags =
+	GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING;
+
+//==========================================================================
+// Class:			CharacterDeviceGPIOBackend::ChipDevice
+// Function:		Open
+//
+// Description:		Opens the GPIO chip device.
+//
+// Input Arguments:
+//		chipFileName	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		int, file descriptor, or -1 on failure (reason in errno)
+//
+//==========================================================================
+int CharacterDeviceGPIOBackend::ChipDevice::Open(const std::string& chipFileName)
+{
+	return open(chipFileName.c_str(), O_RDWR | O_CLOEXEC);
+}
+
+//==========================================================================
+// Class:			CharacterDeviceGPIOBackend::ChipDevice
+// Function:		Ioctl
+//
+// Description:		Performs an ioctl on the chip or a line request.
+//
+// Input Arguments:
+//		fileDescriptor	= const int&
+//		request			= const unsigned long&
+//		argument		= void*
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		int, -1 on failure (reason in errno)
+//
+//==========================================================================
+int CharacterDeviceGPIOBackend::ChipDevice::Ioctl(const int& fileDescriptor,
+	const unsigned long& request, void* argument)
+{
+	return ioctl(fileDescriptor, request, argument);
+}
+
+//==========================================================================
+// Class:			CharacterDeviceGPIOBackend
+// Function:		GetDefaultChipDevice
+//
+// Description:		Returns the object that talks to the real GPIO character
+//					device.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		ChipDevice&
+//
+//==========================================================================
+CharacterDeviceGPIOBackend::ChipDevice& CharacterDeviceGPIOBackend::GetDefaultChipDevice()
+{
+	static ChipDevice device;
+	return device;
+}
+
+//==========================================================================
+// Class:			CharacterDeviceGPIOBackend
+// Function:		CharacterDeviceGPIOBackend
+//
+// Description:		Constructor for CharacterDeviceGPIOBackend class.
+//
+// Input Arguments:
+//		chipFileName	= const std::string&, GPIO chip device to use
+//		outStream		= std::ostream&
+//		consumer		= const std::string&, label attached to requested lines
+//		device			= ChipDevice&, performs the system calls on the chip
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+CharacterDeviceGPIOBackend::CharacterDeviceGPIOBackend(const std::string& chipFileName,
+	std::ostream& outStream, const std::string& consumer, ChipDevice& device) : consumer(consumer),
+	outStream(outStream), device(device), chipLineCount(0), requestFileDescriptor(-1),
+	dispatchingInterrupt(nullptr), epollFileDescriptor(-1), wakeFileDescriptor(-1),
+	stopEventThread(false)
+{
+	chipFileDescriptor = device.Open(chipFileName);
+	if (chipFileDescriptor == -1)
+	{
+		outStream << "Failed to open '" << chipFileName << "':  " << strerror(errno) << std::endl;
+		return;
+	}
+
+	gpiochip_info info;
+	memset(&info, 0, sizeof(info));
+	if (device.Ioctl(chipFileDescriptor, GPIO_GET_CHIPINFO_IOCTL, &info) == -1)
+	{
+		outStream << "Failed to get chip info for '" << chipFileName << "':  " << strerror(errno) << std::endl;
+		close(chipFileDescriptor);
+		chipFileDescriptor = -1;
+		return;
+	}
+
+	chipLineCount = info.lines;
+	lines.resize(chipLineCount);
+
+	epollFileDescriptor = epoll_create1(EPOLL_CLOEXEC);
+	wakeFileDescriptor = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (epollFileDescriptor == -1 || wakeFileDescriptor == -1)
+	{
+		outStream << "Failed to create event descriptors:  " << strerror(errno) << std::endl;
+		return;
+	}
+
+	epoll_event event;
+	memset(&event, 0, sizeof(event));
+	event.events = EPOLLIN;
+	event.data.fd = wakeFileDescriptor;
+	if (epoll_ctl(epollFileDescriptor, EPOLL_CTL_ADD, wakeFileDescriptor, &event) == -1)
+		outStream << "Failed to register wake descriptor:  " << strerror(errno) << std::endl;
+}
+
+//==========================================================================
+// Class:			CharacterDeviceGPIOBackend
+// Function:		~CharacterDeviceGPIOBackend
+//
+// Description:		Destructor for CharacterDeviceGPIOBackend class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+CharacterDeviceGPIOBackend::~CharacterDeviceGPIOBackend()
+{
+	if (eventThread.joinable())
+	{
+		stopEventThread = true;
+		const uint64_t wake(1);
+		if (write(wakeFileDescriptor, &wake, sizeof(wake)) != sizeof(wake))
+			outStream << "Failed to wake event thread:  " << strerror(errno) << std::endl;
+		eventThread.join();
+	}
+
+	if (requestFileDescriptor != -1)
+		close(requestFileDescriptor);
+	if (wakeFileDescriptor != -1)
+		close(wakeFileDescriptor);
+	if (epollFileDescriptor != -1)
+		close(epollFileDescriptor);
+	if (chipFileDescriptor != -1)
+		close(chipFileDescriptor);
+}
+
+//==========================================================================
+// Class:			CharacterDeviceGPIOBackend
+// Function:		SetDataDirection
+//
+// Description:		Sets the data direction for the pin.  The first call for
+//					a pin adds its line to the line request.
+//
+// Input Arguments:
+//		pin			= const int&
+//		direction	= const GPIO::DataDirection&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CharacterDeviceGPIOBackend::SetDataDirection(const int &pin, const GPIO::DataDirection &direction)
+{
+	assert(ChipOK());
+
+	if (direction == GPIO::DataDirection::PWMOutput)
+	{
+		outStream << "PWM output is not supported by the character device backend (pin "
+			<< pin << ")" << std::endl;
+		return;
+	}
+
+	unsigned int offset;
+	if (!GetOffset(pin, offset))
+		return;
+
+	std::lock_guard<std::mutex> lock(configMutex);
+	uint64_t flags(lines[offset].flags & biasFlags);
+	if (direction == GPIO::DataDirection::Input)
+		flags |= GPIO_V2_LINE_FLAG_INPUT | (lines[offset].flags & edgeFlags);
+	else
+		flags |= GPIO_V2_LINE_FLAG_OUTPUT;
+
+	ConfigureLine(offset, flags);
+}
+
+//==========================================================================
+// Class:			CharacterDeviceGPIOBackend
+// Function:		SetPullUpDown
+//
+// Description:		Sets the state of the optional internal pull-up/pull-down resistors.
+//
+// Input Arguments:
+//		pin		= const int&
+//		state	= const GPIO::PullResistance&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CharacterDeviceGPIOBackend::SetPullUpDown(const int &pin, const GPIO::PullResistance &state)
+{
+	assert(ChipOK());
+
+	uint64_t bias;
+	if (state == GPIO::PullResistance::Off)
+		bias = GPIO_V2_LINE_FLAG_BIAS_DISABLED;
+	else if (state == GPIO::PullResistance::PullUp)
+		bias = GPIO_V2_LINE_FLAG_BIAS_PULL_UP;
+	else if (state == GPIO::PullResistance::PullDown)
+		bias = GPIO_V2_LINE_FLAG_BIAS_PULL_DOWN;
+	else
+	{
+		assert(false);
+		return;
+	}
+
+	unsigned int offset;
+	if (!GetOffset(pin, offset))
+		return;
+
+	std::lock_guard<std::mutex> lock(configMutex);
+	Line& line(lines[offset]);
+	line.flags = (line.flags & ~biasFlags) | bias;
+
+	// The kernel rejects bias settings on lines without a direction, so
+	// lines that have not been requested yet just remember the setting
+	if (line.requestIndex >= 0)
+		ReconfigureLines();
+}
+
+//==========================================================================
+// Class:			CharacterDeviceGPIOBackend
+// Function:		SetOutput
+//
+// Description:		Sets the state of the output pin.  Calls for pins that
+//					are not outputs are ignored.  The configuration lock is
+//					held so the line request can't be replaced mid-call.
+//
+// Input Arguments:
+//		pin		= const int&
+//		high	= const bool&, true for high, false for low
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CharacterDeviceGPIOBackend::SetOutput(const int &pin, const bool &high)
+{
+	unsigned int offset;
+	if (!GetOffset(pin, offset))
+		return;
+
+	std::lock_guard<std::mutex> lock(configMutex);
+	if ((lines[offset].flags & GPIO_V2_LINE_FLAG_OUTPUT) == 0 || lines[offset].requestIndex < 0)
+		return;
+
+	gpio_v2_line_values values;
+	values.mask = 1ULL << lines[offset].requestIndex;
+	values.bits = high ? values.mask : 0;
+	if (device.Ioctl(requestFileDescriptor, GPIO_V2_LINE_SET_VALUES_IOCTL, &values) == -1)
+		outStream << "Failed to set line " << offset << ":  " << strerror(errno) << std::endl;
+}
+
+//==========================================================================
+// Class:			CharacterDeviceGPIOBackend
+// Function:		GetInput
+//
+// Description:		Reads the status of the input pin.
+//
+// Input Arguments:
+//		pin	= const int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for high, false otherwise
+//
+//==========================================================================
+bool CharacterDeviceGPIOBackend::GetInput(const int &pin)
+{
+	std::lock_guard<std::mutex> lock(configMutex);
+	const int requestIndex(GetRequestIndex(pin));
+	if (requestIndex < 0)
+	{
+		outStream << "Pin " << pin << " has not been configured" << std::endl;
+		return false;
+	}
+
+	gpio_v2_line_values values;
+	values.mask = 1ULL << requestIndex;
+	values.bits = 0;
+	if (device.Ioctl(requestFileDescriptor, GPIO_V2_LINE_GET_VALUES_IOCTL, &values) == -1)
+	{
+		outStream << "Failed to read line for pin " << pin << ":  " << strerror(errno) << std::endl;
+		return false;
+	}
+
+	return (values.bits & values.mask) != 0;
+}
+
+//==========================================================================
+// Class:			CharacterDeviceGPIOBackend
+// Function:		SetOutputs
+//
+// Description:		Sets the state of several output pins with one ioctl.
+//
+// Input Arguments:
+//		pins	= const std::vector<int>&
+//		values	= const uint32_t&, bit i is the desired state of pins[i]
+//		mask	= const uint32_t&, only pins with the corresponding bit set
+//				  are changed
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CharacterDeviceGPIOBackend::SetOutputs(const std::vector<int> &pins,
+	const uint32_t &values, const uint32_t &mask)
+{
+	assert(pins.size() <= 32);
+
+	gpio_v2_line_values lineValues;
+	lineValues.mask = 0;
+	lineValues.bits = 0;
+
+	std::lock_guard<std::mutex> lock(configMutex);
+	unsigned int i;
+	for (i = 0; i < pins.size(); i++)
+	{
+		if ((mask & (1u << i)) == 0)
+			continue;
+
+		const int requestIndex(GetRequestIndex(pins[i]));
+		if (requestIndex < 0)
+		{
+			outStream << "Pin " << pins[i] << " has not been configured" << std::endl;
+			return;
+		}
+
+		const uint64_t bit(1ULL << requestIndex);
+		lineValues.mask |= bit;
+		if (values & (1u << i))
+			lineValues.bits |= bit;
+	}
+
+	if (lineValues.mask != 0 &&
+		device.Ioctl(requestFileDescriptor, GPIO_V2_LINE_SET_VALUES_IOCTL, &lineValues) == -1)
+		outStream << "Failed to set lines:  " << strerror(errno) << std::endl;
+}
+
+//==========================================================================
+// Class:			CharacterDeviceGPIOBackend
+// Function:		GetInputs
+//
+// Description:		Reads the state of several input pins with one ioctl.
+//
+// Input Arguments:
+//		pins	= const std::vector<int>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		uint32_t, bit i is set if pins[i] is high
+//
+//==========================================================================
+uint32_t CharacterDeviceGPIOBackend::GetInputs(const std::vector<int> &pins)
+{
+	assert(pins.size() <= 32);
+
+	gpio_v2_line_values lineValues;
+	lineValues.mask = 0;
+	lineValues.bits = 0;
+
+	std::lock_guard<std::mutex> lock(configMutex);
+	int requestIndices[32];
+	unsigned int i;
+	for (i = 0; i < pins.size(); i++)
+	{
+		requestIndices[i] = GetRequestIndex(pins[i]);
+		if (requestIndices[i] < 0)
+		{
+			outStream << "Pin " << pins[i] << " has not been configured" << std::endl;
+			return 0;
+		}
+
+		lineValues.mask |= 1ULL << requestIndices[i];
+	}
+
+	if (device.Ioctl(requestFileDescriptor, GPIO_V2_LINE_GET_VALUES_IOCTL, &lineValues) == -1)
+	{
+		outStream << "Failed to read lines:  " << strerror(errno) << std::endl;
+		return 0;
+	}
+
+	uint32_t values(0);
+	for (i = 0; i < pins.size(); i++)
+	{
+		if (lineValues.bits & (1ULL << requestIndices[i]))
+			values |= 1u << i;
+	}
+
+	return values;
+}
+
+//==========================================================================
+// Class:			CharacterDeviceGPIOBackend
+// Function:		AttachInterrupt
+//
+// Description:		Enables edge detection for the interrupt's line.  Events
+//					are delivered to the interrupt from the event thread.
+//
+// Input Arguments:
+//		interrupt	= Interrupt&
+//		edge		= const Interrupt::EdgeDirection&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool CharacterDeviceGPIOBackend::AttachInterrupt(Interrupt &interrupt, const Interrupt::EdgeDirection &edge)
+{
+	assert(ChipOK());
+
+	uint64_t edgeFlag;
+	if (edge == Interrupt::EdgeDirection::Rising)
+		edgeFlag = GPIO_V2_LINE_FLAG_EDGE_RISING;
+	else if (edge == Interrupt::EdgeDirection::Falling)
+		edgeFlag = GPIO_V2_LINE_FLAG_EDGE_FALLING;
+	else if (edge == Interrupt::EdgeDirection::Both ||
+		edge == Interrupt::EdgeDirection::Preconfigured)// Nothing to inherit from outside the request
+		edgeFlag = edgeFlags;
+	else
+	{
+		assert(false);
+		return false;
+	}
+
+	unsigned int offset;
+	if (!GetOffset(interrupt.GetPin(), offset))
+		return false;
+
+	{
+		std::lock_guard<std::mutex> lock(configMutex);
+		Line& line(lines[offset]);
+		if (line.interrupt && line.interrupt != &interrupt)
+		{
+			outStream << "Line " << offset << " already has an interrupt attached" << std::endl;
+			return false;
+		}
+
+		line.interrupt = &interrupt;
+		if (!ConfigureLine(offset, (line.flags & biasFlags) | GPIO_V2_LINE_FLAG_INPUT | edgeFlag))
+		{
+			line.interrupt = nullptr;
+			return false;
+		}
+	}
+
+	if (!eventThread.joinable())
+		eventThread = std::thread(&CharacterDeviceGPIOBackend::EventThreadEntry, this);
+
+	return true;
+}
+
+//==========================================================================
+// Class:			CharacterDeviceGPIOBackend
+// Function:		DetachInterrupt
+//
+// Description:		Disables edge detection for the interrupt's line.  Once
+//					this returns, the interrupt will not be called again.  If
+//					the interrupt is being called on the event thread, waits
+//					for it to return (unless this is called from the event
+//					thread itself, i.e. from within a service routine).
+//
+// Input Arguments:
+//		interrupt	= Interrupt&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CharacterDeviceGPIOBackend::DetachInterrupt(Interrupt &interrupt)
+{
+	unsigned int offset;
+	if (!GetOffset(interrupt.GetPin(), offset))
+		return;
+
+	std::unique_lock<std::mutex> lock(configMutex);
+	Line& line(lines[offset]);
+	if (line.interrupt != &interrupt)
+		return;
+
+	line.interrupt = nullptr;
+	line.flags &= ~edgeFlags;
+	ReconfigureLines();
+
+	if (std::this_thread::get_id() != eventThread.get_id())
+	{
+		dispatchComplete.wait(lock, [this, &interrupt]()
+		{
+			return dispatchingInterrupt != &interrupt;
+		});
+	}
+}
+
+//==========================================================================
+// Class:			CharacterDeviceGPIOBackend
+// Function:		GetRequestIndex
+//
+// Description:		Returns the bit position of the pin's line within the
+//					line request.  Caller must hold configMutex.
+//
+// Input Arguments:
+//		pin	= const int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		int, or -1 if the pin's line has not been requested
+//
+//==========================================================================
+int CharacterDeviceGPIOBackend::GetRequestIndex(const int &pin) const
+{
+	const unsigned int offset(WiringPiToBCM(pin));
+	if (offset >= chipLineCount)
+		return -1;
+
+	return lines[offset].requestIndex;
+}
+
+//==========================================================================
+// Class:			CharacterDeviceGPIOBackend
+// Function:		GetOffset
+//
+// Description:		Finds the chip line offset (Broadcom GPIO number) for the
+//					pin, reporting pins that aren't on the chip.
+//
+// Input Arguments:
+//		pin	= const int&
+//
+// Output Arguments:
+//		offset	= unsigned int&
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool CharacterDeviceGPIOBackend::GetOffset(const int &pin, unsigned int &offset) const
+{
+	offset = WiringPiToBCM(pin);
+	if (offset < chipLineCount)
+		return true;
+
+	outStream << "Pin " << pin << " is not on this chip" << std::endl;
+	return false;
+}
+
+//==========================================================================
+// Class:			CharacterDeviceGPIOBackend
+// Function:		ConfigureLine
+//
+// Description:		Applies new flags to a line, adding it to the line request
+//					if necessary.  Caller must hold configMutex.
+//
+// Input Arguments:
+//		offset	= const unsigned int&
+//		flags	= const uint64_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool CharacterDeviceGPIOBackend::ConfigureLine(const unsigned int &offset, const uint64_t &flags)
+{
+	Line& line(lines[offset]);
+	line.flags = flags;
+
+	if (line.requestIndex >= 0)
+		return ReconfigureLines();
+
+	if (requestedOffsets.size() >= GPIO_V2_LINES_MAX)
+	{
+		outStream << "Cannot request more than " << GPIO_V2_LINES_MAX << " lines" << std::endl;
+		return false;
+	}
+
+	line.requestIndex = requestedOffsets.size();
+	requestedOffsets.push_back(offset);
+	if (RequestLines())
+		return true;
+
+	// Put the remaining lines back the way they were
+	line.requestIndex = -1;
+	requestedOffsets.pop_back();
+	if (!requestedOffsets.empty())
+		RequestLines();
+
+	return false;
+}
+
+//==========================================================================
+// Class:			CharacterDeviceGPIOBackend
+// Function:		BuildLineConfig
+//
+// Description:		Builds the line configuration for the current set of
+//					requested lines.  The most common flags become the
+//					default and every other distinct set of flags uses one
+//					attribute, as does the set of output values.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		config	= gpio_v2_line_config&
+//
+// Return Value:
+//		bool, true for success, false if too many distinct configurations
+//
+//==========================================================================
+bool CharacterDeviceGPIOBackend::BuildLineConfig(gpio_v2_line_config &config)
+{
+	memset(&config, 0, sizeof(config));
+
+	std::map<uint64_t, uint64_t> flagsToMask;
+	uint64_t outputMask(0), outputValues(0);
+	unsigned int i;
+	for (i = 0; i < requestedOffsets.size(); i++)
+	{
+		const Line& line(lines[requestedOffsets[i]]);
+		flagsToMask[line.flags] |= 1ULL << i;
+		if (line.flags & GPIO_V2_LINE_FLAG_OUTPUT)
+		{
+			outputMask |= 1ULL << i;
+			if (line.outputValue)
+				outputValues |= 1ULL << i;
+		}
+	}
+
+	const unsigned int requiredAttributes(flagsToMask.size() - 1 + (outputMask != 0 ? 1 : 0));
+	if (requiredAttributes > GPIO_V2_LINE_NUM_ATTRS_MAX)
+	{
+		outStream << "Too many distinct line configurations for one line request" << std::endl;
+		return false;
+	}
+
+	unsigned int mostCommonCount(0);
+	for (const auto& entry : flagsToMask)
+	{
+		const unsigned int count(std::bitset<64>(entry.second).count());
+		if (count > mostCommonCount)
+		{
+			mostCommonCount = count;
+			config.flags = entry.first;
+		}
+	}
+
+	for (const auto& entry : flagsToMask)
+	{
+		if (entry.first == config.flags)
+			continue;
+
+		gpio_v2_line_config_attribute& attribute(config.attrs[config.num_attrs++]);
+		attribute.attr.id = GPIO_V2_LINE_ATTR_ID_FLAGS;
+		attribute.attr.flags = entry.first;
+		attribute.mask = entry.second;
+	}
+
+	if (outputMask != 0)
+	{
+		gpio_v2_line_config_attribute& attribute(config.attrs[config.num_attrs++]);
+		attribute.attr.id = GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES;
+		attribute.attr.values = outputValues;
+		attribute.mask = outputMask;
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			CharacterDeviceGPIOBackend
+// Function:		CaptureOutputValues
+//
+// Description:		Reads back the current state of all output lines so that
+//					reconfiguring the request does not disturb them.  Caller
+//					must hold configMutex.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CharacterDeviceGPIOBackend::CaptureOutputValues()
+{
+	if (requestFileDescriptor == -1)
+		return;
+
+	gpio_v2_line_values values;
+	values.mask = 0;
+	values.bits = 0;
+
+	unsigned int i;
+	for (i = 0; i < requestedOffsets.size(); i++)
+	{
+		if (lines[requestedOffsets[i]].flags & GPIO_V2_LINE_FLAG_OUTPUT)
+			values.mask |= 1ULL << i;
+	}
+
+	if (values.mask == 0)
+		return;
+
+	if (device.Ioctl(requestFileDescriptor, GPIO_V2_LINE_GET_VALUES_IOCTL, &values) == -1)
+	{
+		outStream << "Failed to read back output lines:  " << strerror(errno) << std::endl;
+		return;
+	}
+
+	for (i = 0; i < requestedOffsets.size(); i++)
+		lines[requestedOffsets[i]].outputValue = (values.bits & (1ULL << i)) != 0;
+}
+
+//==========================================================================
+// Class:			CharacterDeviceGPIOBackend
+// Function:		RequestLines
+//
+// Description:		Releases the current line request (if any) and requests
+//					all lines again.  Needed whenever a new line is added.
+//					Caller must hold configMutex.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool CharacterDeviceGPIOBackend::RequestLines()
+{
+	CaptureOutputValues();
+
+	if (requestFileDescriptor != -1)
+	{
+		epoll_ctl(epollFileDescriptor, EPOLL_CTL_DEL, requestFileDescriptor, nullptr);
+		close(requestFileDescriptor);
+		requestFileDescriptor = -1;
+	}
+
+	gpio_v2_line_request request;
+	memset(&request, 0, sizeof(request));
+	if (!BuildLineConfig(request.config))
+		return false;
+
+	unsigned int i;
+	for (i = 0; i < requestedOffsets.size(); i++)
+		request.offsets[i] = requestedOffsets[i];
+	request.num_lines = requestedOffsets.size();
+	strncpy(request.consumer, consumer.c_str(), GPIO_MAX_NAME_SIZE - 1);
+
+	if (device.Ioctl(chipFileDescriptor, GPIO_V2_GET_LINE_IOCTL, &request) == -1)
+	{
+		outStream << "Failed to request lines:  " << strerror(errno) << std::endl;
+		return false;
+	}
+
+	// Events are drained until the read would block
+	fcntl(request.fd, F_SETFL, fcntl(request.fd, F_GETFL) | O_NONBLOCK);
+
+	epoll_event event;
+	memset(&event, 0, sizeof(event));
+	event.events = EPOLLIN;
+	event.data.fd = request.fd;
+	if (epoll_ctl(epollFileDescriptor, EPOLL_CTL_ADD, request.fd, &event) == -1)
+		outStream << "Failed to register line request for events:  " << strerror(errno) << std::endl;
+
+	requestFileDescriptor = request.fd;
+	return true;
+}
+
+//==========================================================================
+// Class:			CharacterDeviceGPIOBackend
+// Function:		ReconfigureLines
+//
+// Description:		Applies the current line flags to the existing request.
+//					Caller must hold configMutex.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool CharacterDeviceGPIOBackend::ReconfigureLines()
+{
+	if (requestFileDescriptor == -1)
+		return false;
+
+	CaptureOutputValues();
+
+	gpio_v2_line_config config;
+	if (!BuildLineConfig(config))
+		return false;
+
+	if (device.Ioctl(requestFileDescriptor, GPIO_V2_LINE_SET_CONFIG_IOCTL, &config) == -1)
+	{
+		outStream << "Failed to reconfigure lines:  " << strerror(errno) << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			CharacterDeviceGPIOBackend
+// Function:		EventThreadEntry
+//
+// Description:		Entry point for the thread that services edge events.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CharacterDeviceGPIOBackend::EventThreadEntry()
+{
+	const unsigned int maxEvents(4);
+	epoll_event events[maxEvents];
+
+	while (!stopEventThread)
+	{
+		const int count(epoll_wait(epollFileDescriptor, events, maxEvents, -1));
+		if (count == -1)
+		{
+			if (errno == EINTR)
+				continue;
+
+			outStream << "Failed to wait for line events:  " << strerror(errno) << std::endl;
+			return;
+		}
+
+		int i;
+		for (i = 0; i < count; i++)
+		{
+			if (events[i].data.fd == wakeFileDescriptor)
+			{
+				uint64_t wake;
+				if (read(wakeFileDescriptor, &wake, sizeof(wake)) == -1 && errno != EAGAIN)
+					outStream << "Failed to clear wake descriptor:  " << strerror(errno) << std::endl;
+			}
+			else
+				DispatchEvents();
+		}
+	}
+}
+
+//==========================================================================
+// Class:			CharacterDeviceGPIOBackend
+// Function:		DispatchEvents
+//
+// Description:		Reads all pending edge events and passes them to the
+//					attached interrupts.  The configuration lock is released
+//					while each interrupt is called, so service routines may
+//					use this backend; DetachInterrupt waits for a call in
+//					progress to finish.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void CharacterDeviceGPIOBackend::DispatchEvents()
+{
+	std::unique_lock<std::mutex> lock(configMutex);
+
+	const unsigned int bufferSize(16);
+	gpio_v2_line_event events[bufferSize];
+	ssize_t readSize;
+	while (readSize = read(requestFileDescriptor, events, sizeof(events)), readSize > 0)
+	{
+		const unsigned int count(readSize / sizeof(gpio_v2_line_event));
+		unsigned int i;
+		for (i = 0; i < count; i++)
+		{
+			// Looked up again for every event, in case a service routine
+			// detached an interrupt
+			if (events[i].offset >= chipLineCount || !lines[events[i].offset].interrupt)
+				continue;
+
+			const Interrupt::Clock::time_point time(std::chrono::duration_cast<Interrupt::Clock::duration>(
+				std::chrono::nanoseconds(events[i].timestamp_ns)));
+			dispatchingInterrupt = lines[events[i].offset].interrupt;
+
+			lock.unlock();
+			dispatchingInterrupt->HandleEdge(events[i].id == GPIO_V2_LINE_EVENT_RISING_EDGE, time);
+			lock.lock();
+
+			dispatchingInterrupt = nullptr;
+			dispatchComplete.notify_all();
+		}
+	}
+
+	if (readSize == -1 && errno != EAGAIN)
+		outStream << "Failed to read line events:  " << strerror(errno) << std::endl;
+}
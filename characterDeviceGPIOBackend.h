@@ -0,0 +1,114 @@
+// File:  characterDeviceGPIOBackend.h
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  GPIO backend built on the Linux GPIO character device (uAPI v2).
+//        Every line used through this backend belongs to a single line
+//        request, so any group of lines can be read or written with one
+//        ioctl and all edge events arrive (with kernel timestamps) on one
+//        file descriptor, serviced by one thread.
+
+#ifndef CHARACTER_DEVICE_GPIO_BACKEND_H_
+#define CHARACTER_DEVICE_GPIO_BACKEND_H_
+
+// Standard C++ headers
+#include <string>
+#include <iostream>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+
+// Linux headers
+#include <linux/gpio.h>
+
+// Local headers
+#include "gpioBackend.h"
+
+class CharacterDeviceGPIOBackend : public GPIOBackend
+{
+public:
+	// Performs the system calls on the chip and line request descriptors;
+	// tests can substitute a fake chip.  Descriptors returned for line
+	// requests must support read, epoll and close.
+	class ChipDevice
+	{
+	public:
+		virtual ~ChipDevice() {}
+		virtual int Open(const std::string& chipFileName);
+		virtual int Ioctl(const int& fileDescriptor, const unsigned long& request, void* argument);
+	};
+
+	static ChipDevice& GetDefaultChipDevice();
+
+	CharacterDeviceGPIOBackend(const std::string& chipFileName = "/dev/gpiochip0",
+		std::ostream& outStream = std::cout, const std::string& consumer = "rpi",
+		ChipDevice& device = GetDefaultChipDevice());
+	virtual ~CharacterDeviceGPIOBackend();
+
+	virtual void SetDataDirection(const int &pin, const GPIO::DataDirection &direction);
+	virtual void SetPullUpDown(const int &pin, const GPIO::PullResistance &state);
+	virtual void SetOutput(const int &pin, const bool &high);
+	virtual bool GetInput(const int &pin);
+
+	virtual void SetOutputs(const std::vector<int> &pins, const uint32_t &values, const uint32_t &mask);
+	virtual uint32_t GetInputs(const std::vector<int> &pins);
+
+	virtual bool AttachInterrupt(Interrupt &interrupt, const Interrupt::EdgeDirection &edge);
+	virtual void DetachInterrupt(Interrupt &interrupt);
+
+	bool ChipOK() const { return chipFileDescriptor != -1; }
+
+private:
+	const std::string consumer;
+	std::ostream& outStream;
+	ChipDevice& device;
+
+	int chipFileDescriptor;
+	unsigned int chipLineCount;
+
+	struct Line
+	{
+		int requestIndex = -1;// bit position within the line request, or -1 if not requested
+		uint64_t flags = 0;
+		bool outputValue = false;
+		Interrupt *interrupt = nullptr;
+	};
+
+	// Indexed by line offset (Broadcom GPIO number)
+	std::vector<Line> lines;
+	std::vector<unsigned int> requestedOffsets;
+
+	// Guards the line table and the line request, which is replaced when
+	// lines are added, so reads and writes take it too.  It is not held
+	// while interrupts are called.
+	std::mutex configMutex;
+	std::atomic<int> requestFileDescriptor;
+
+	Interrupt *dispatchingInterrupt;// Being called on the event thread
+	std::condition_variable dispatchComplete;
+
+	int epollFileDescriptor;
+	int wakeFileDescriptor;
+	std::thread eventThread;
+	std::atomic<bool> stopEventThread;
+
+	bool ConfigureLine(const unsigned int &offset, const uint64_t &flags);
+	bool BuildLineConfig(gpio_v2_line_config &config);
+	void CaptureOutputValues();
+	bool RequestLines();
+	bool ReconfigureLines();
+
+	int GetRequestIndex(const int &pin) const;
+	bool GetOffset(const int &pin, unsigned int &offset) const;
+
+	void EventThreadEntry();
+	void DispatchEvents();
+
+	static const uint64_t biasFlags;
+	static const uint64_t edgeFlags;
+};
+
+#endif// CHARACTER_DEVICE_GPIO_BACKEND_H_
@@ -0,0 +1,267 @@
+// File:  ds18b20Bus.cpp
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  Reads every DS18B20 on a 1-wire bus.  A single conversion is started
+//        on all sensors at once through the bus master's therm_bulk_read
+//        attribute, so a full sweep takes about one conversion time (750 ms
+//        at 12-bit resolution) instead of one per sensor.
+
+// Standard C++ headers
+#include <cstring>
+#include <cerrno>
+#include <charconv>
+#include <thread>
+
+// *nix standard headers
+#include <fcntl.h>
+#include <unistd.h>
+
+// Local headers
+#include "ds18b20Bus.h"
+
+//==========================================================================
+// Class:			DS18B20Bus
+// Function:		None
+//
+// Description:		Static and constant member initialization/definitions for
+//					DS18B20Bus class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const std::string DS18B20Bus::bulkReadFile = "/therm_bulk_read";
+const std::chrono::milliseconds DS18B20Bus::conversionTimeout(1500);
+const std::chrono::milliseconds DS18B20Bus::pollInterval(10);
+
+//==========================================================================
+// Class:			DS18B20Bus
+// Function:		DS18B20Bus
+//
+// Description:		Constructor for DS18B20Bus class.
+//
+// Input Arguments:
+//		outStream		= UString::OStream& (optional)
+//		baseDirectory	= std::string (optional, default should be fine for Raspian OS)
+//		masterName		= std::string (optional, name of the bus master directory)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+DS18B20Bus::DS18B20Bus(UString::OStream& outStream, std::string baseDirectory,
+	std::string masterName) : outStream(outStream), baseDirectory(baseDirectory),
+	masterName(masterName), bulkReadFileDescriptor(-1)
+{
+	Refresh();
+}
+
+//==========================================================================
+// Class:			DS18B20Bus
+// Function:		~DS18B20Bus
+//
+// Description:		Destructor for DS18B20Bus class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+DS18B20Bus::~DS18B20Bus()
+{
+	if (bulkReadFileDescriptor != -1)
+		close(bulkReadFileDescriptor);
+}
+
+//==========================================================================
+// Class:			DS18B20Bus
+// Function:		Refresh
+//
+// Description:		Builds the list of sensors on the bus and opens the bulk
+//					read attribute.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DS18B20Bus::Refresh()
+{
+	sensorIDs = DS18B20::GetConnectedSensors(baseDirectory);
+
+	sensors.clear();
+	for (const auto& id : sensorIDs)
+		sensors.push_back(std::make_unique<DS18B20>(id, outStream, baseDirectory));
+
+	if (bulkReadFileDescriptor == -1)
+	{
+		// Older kernels don't have this attribute - not an error, but reads will be slower
+		bulkReadFileDescriptor = open((baseDirectory + masterName + bulkReadFile).c_str(), O_RDWR | O_CLOEXEC);
+		if (bulkReadFileDescriptor == -1)
+			outStream << "Bulk conversions not available (" << strerror(errno)
+				<< "); sensors will be read one at a time" << std::endl;
+	}
+}
+
+//==========================================================================
+// Class:			DS18B20Bus
+// Function:		GetSensorIDs
+//
+// Description:		Returns the IDs of the sensors found by the most recent scan.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::vector<std::string>
+//
+//==========================================================================
+std::vector<std::string> DS18B20Bus::GetSensorIDs() const
+{
+	return sensorIDs;
+}
+
+//==========================================================================
+// Class:			DS18B20Bus
+// Function:		ReadAll
+//
+// Description:		Starts a conversion on every sensor, waits for it to
+//					complete and then collects the results.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		readings	= std::vector<Reading>&, one per sensor
+//
+// Return Value:
+//		bool, true if every sensor was read successfully, false otherwise
+//
+//==========================================================================
+bool DS18B20Bus::ReadAll(std::vector<Reading>& readings)
+{
+	// If the bulk conversion fails, each sensor read starts its own conversion
+	if (BulkReadSupported() && (!TriggerConversion() || !WaitForConversion()))
+		outStream << "Bulk conversion failed; reading sensors one at a time" << std::endl;
+
+	readings.resize(sensors.size());
+	bool allValid(true);
+	unsigned int i;
+	for (i = 0; i < sensors.size(); i++)
+	{
+		readings[i].deviceID = sensorIDs[i];
+		readings[i].valid = sensors[i]->GetTemperature(readings[i].temperature);
+		if (!readings[i].valid)
+			allValid = false;
+	}
+
+	return allValid;
+}
+
+//==========================================================================
+// Class:			DS18B20Bus
+// Function:		TriggerConversion
+//
+// Description:		Starts a simultaneous conversion on all sensors on the bus.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool DS18B20Bus::TriggerConversion() const
+{
+	const char command[] = "trigger\n";
+	if (pwrite(bulkReadFileDescriptor, command, sizeof(command) - 1, 0) !=
+		static_cast<ssize_t>(sizeof(command) - 1))
+	{
+		outStream << "Failed to trigger bulk conversion:  " << strerror(errno) << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			DS18B20Bus
+// Function:		WaitForConversion
+//
+// Description:		Polls the bulk read attribute until no conversions are in
+//					progress.  The attribute reads -1 while any sensor is
+//					still converting, 1 once the results are ready and 0 if
+//					no bulk conversion is pending.  Anything else is an
+//					error.  A conversion takes at least 94 ms (9-bit
+//					resolution), so the first poll is delayed by one interval.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool DS18B20Bus::WaitForConversion() const
+{
+	const auto deadline(std::chrono::steady_clock::now() + conversionTimeout);
+	while (true)
+	{
+		std::this_thread::sleep_for(pollInterval);
+
+		char data[16];
+		const ssize_t size(pread(bulkReadFileDescriptor, data, sizeof(data), 0));
+		if (size <= 0)
+		{
+			outStream << "Failed to read bulk conversion status" << std::endl;
+			return false;
+		}
+
+		int status;
+		if (std::from_chars(data, data + size, status).ec != std::errc() ||
+			(status != -1 && status != 0 && status != 1))
+		{
+			outStream << "Unexpected bulk conversion status:  '"
+				<< std::string(data, data + size - (data[size - 1] == '\n' ? 1 : 0)) << "'" << std::endl;
+			return false;
+		}
+
+		if (status != -1)
+			return true;
+
+		if (std::chrono::steady_clock::now() > deadline)
+		{
+			outStream << "Timed out waiting for bulk conversion" << std::endl;
+			return false;
+		}
+	}
+}
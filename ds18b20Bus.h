@@ -0,0 +1,67 @@
+// File:  ds18b20Bus.h
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  Reads every DS18B20 on a 1-wire bus.  A single conversion is started
+//        on all sensors at once through the bus master's therm_bulk_read
+//        attribute, so a full sweep takes about one conversion time (750 ms
+//        at 12-bit resolution) instead of one per sensor.
+
+#ifndef DS18B20_BUS_H_
+#define DS18B20_BUS_H_
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+
+// Local headers
+#include "ds18b20Sensor.h"
+#include "utilities/uString.h"
+
+class DS18B20Bus
+{
+public:
+	DS18B20Bus(UString::OStream& outStream = Cout,
+		std::string baseDirectory = "/sys/bus/w1/devices/",
+		std::string masterName = "w1_bus_master1");
+	~DS18B20Bus();
+
+	// Re-scans the bus for sensors (also done on construction)
+	void Refresh();
+	std::vector<std::string> GetSensorIDs() const;
+
+	struct Reading
+	{
+		std::string deviceID;
+		bool valid;
+		double temperature;// [deg C]
+	};
+
+	// Returns true if every sensor was read successfully.  Falls back to
+	// reading the sensors one at a time if the kernel doesn't support bulk
+	// conversions.
+	bool ReadAll(std::vector<Reading>& readings);
+
+	bool BulkReadSupported() const { return bulkReadFileDescriptor != -1; }
+
+private:
+	static const std::string bulkReadFile;
+	static const std::chrono::milliseconds conversionTimeout;
+	static const std::chrono::milliseconds pollInterval;
+
+	UString::OStream &outStream;
+	const std::string baseDirectory;
+	const std::string masterName;
+
+	std::vector<std::unique_ptr<DS18B20>> sensors;
+	std::vector<std::string> sensorIDs;
+
+	int bulkReadFileDescriptor;
+
+	bool TriggerConversion() const;
+	bool WaitForConversion() const;
+};
+
+#endif// DS18B20_BUS_H_
@@ -9,11 +9,16 @@
 
 // Standard C++ headers
 #include <cstdlib>
-#include <fstream>
+#include <cstring>
+#include <cstdio>
 #include <cassert>
+#include <charconv>
+#include <algorithm>
 
 // *nix standard headers
 #include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 // Local headers
 #include "ds18b20Sensor.h"
@@ -36,7 +41,11 @@
 //
 //==========================================================================
 bool DS18B20::initialized = false;
+std::mutex DS18B20::initializationMutex;
 const std::string DS18B20::deviceFile = "/w1_slave";
+const std::string DS18B20::resolutionFile = "/resolution";
+const unsigned int DS18B20::minResolution = 9;
+const unsigned int DS18B20::maxResolution = 12;
 
 //==========================================================================
 // Class:			DS18B20
@@ -58,44 +67,66 @@ const std::string DS18B20::deviceFile = "/w1_slave";
 //==========================================================================
 DS18B20::DS18B20(std::string deviceID,
 	UString::OStream &outStream, std::string baseDirectory, const unsigned int& allowedRecursions)
-	: deviceID(deviceID), device(baseDirectory + deviceID + deviceFile), outStream(outStream),
-	allowedRecursions(allowedRecursions)
+	: deviceID(deviceID), device(baseDirectory + deviceID + deviceFile),
+	resolutionDevice(baseDirectory + deviceID + resolutionFile), outStream(outStream),
+	allowedRecursions(allowedRecursions), fileDescriptor(-1), readCount(0), crcFailureCount(0),
+	retryCount(0), failureCount(0)
 {
-	if (!initialized)
-	{
-		int ret(system("modprobe w1-gpio"));
-		if (ret == -1)
-		{
-			outStream << "Failed to mount temperature sensor (modprobe w1-gpio):  " << strerror(errno) << std::endl;
-			return;
-		}
-		else if (ret == 127)
-		{
-			outStream << "Failed to mount temperature sensor (modprobe w1-gpio) - could not create child process" << std::endl;
-			return;
-		}
-		
-		ret = system("modprobe w1-therm");
-		if (ret == -1)
-		{
-			outStream << "Failed to mount temperature sensor (modprobe w1-therm):  " << strerror(errno) << std::endl;
-			return;
-		}
-		else if (ret == 127)
-		{
-			outStream << "Failed to mount temperature sensor (modprobe w1-therm) - could not create child process" << std::endl;
-			return;
-		}
-		
-		initialized = true;
-	}
+	LoadKernelModules(outStream);
+}
+
+//==========================================================================
+// Class:			DS18B20
+// Function:		DS18B20
+//
+// Description:		Copy constructor for DS18B20 class.  The copy opens its own
+//					device file.
+//
+// Input Arguments:
+//		sensor	= const DS18B20&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+DS18B20::DS18B20(const DS18B20& sensor) : TemperatureSensor(sensor), deviceID(sensor.deviceID),
+	device(sensor.device), resolutionDevice(sensor.resolutionDevice), outStream(sensor.outStream), allowedRecursions(sensor.allowedRecursions),
+	fileDescriptor(-1), readCount(sensor.readCount.load()), crcFailureCount(sensor.crcFailureCount.load()),
+	retryCount(sensor.retryCount.load()), failureCount(sensor.failureCount.load())
+{
+}
+
+//==========================================================================
+// Class:			DS18B20
+// Function:		~DS18B20
+//
+// Description:		Destructor for DS18B20 class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+DS18B20::~DS18B20()
+{
+	if (fileDescriptor != -1)
+		close(fileDescriptor);
 }
 
 //==========================================================================
 // Class:			DS18B20
 // Function:		GetTemperature
 //
-// Description:		Reads current temperature from DS18B20 sensor.
+// Description:		Reads current temperature from DS18B20 sensor, retrying up
+//					to the number of times specified at construction.
 //
 // Input Arguments:
 //		None
@@ -109,75 +140,361 @@ DS18B20::DS18B20(std::string deviceID,
 //==========================================================================
 bool DS18B20::GetTemperature(double &temperature) const
 {
-	return ReadSensor(temperature, allowedRecursions);
+	unsigned int attempt;
+	for (attempt = 0; attempt < allowedRecursions; attempt++)
+	{
+		if (attempt > 0)
+			retryCount++;
+
+		if (ReadSensor(temperature))
+			return true;
+	}
+
+	failureCount++;
+	return false;
 }
 
 //==========================================================================
 // Class:			DS18B20
-// Function:		ReadSensor
+// Function:		GetStatistics
 //
-// Description:		Reads current temperature from DS18B20 sensor.
+// Description:		Returns the counts of read attempts and failures.
 //
 // Input Arguments:
-//		recursion	= unsigned int, number of attempts to make in the event of repeated errors
+//		None
 //
 // Output Arguments:
-//		temperature	= double& [deg C]
+//		None
+//
+// Return Value:
+//		Statistics
+//
+//==========================================================================
+DS18B20::Statistics DS18B20::GetStatistics() const
+{
+	Statistics statistics;
+	statistics.reads = readCount;
+	statistics.crcFailures = crcFailureCount;
+	statistics.retries = retryCount;
+	statistics.failures = failureCount;
+	return statistics;
+}
+
+//==========================================================================
+// Class:			DS18B20
+// Function:		ResetStatistics
+//
+// Description:		Clears the counts of read attempts and failures.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void DS18B20::ResetStatistics()
+{
+	readCount = 0;
+	crcFailureCount = 0;
+	retryCount = 0;
+	failureCount = 0;
+}
+
+//==========================================================================
+// Class:			DS18B20
+// Function:		SetResolution
+//
+// Description:		Sets the conversion resolution through the w1-therm driver
+//					(requires write access to the sysfs attribute).
+//
+// Input Arguments:
+//		bits	= const unsigned int&, 9 to 12
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool DS18B20::SetResolution(const unsigned int& bits)
+{
+	assert(bits >= minResolution && bits <= maxResolution);
+
+	const int resolutionFileDescriptor(open(resolutionDevice.c_str(), O_WRONLY | O_CLOEXEC));
+	if (resolutionFileDescriptor == -1)
+	{
+		outStream << "Could not open file '" << resolutionDevice << "' for output:  " << strerror(errno) << std::endl;
+		return false;
+	}
+
+	char data[8];
+	const int length(snprintf(data, sizeof(data), "%u\n", bits));
+	const bool ok(write(resolutionFileDescriptor, data, length) == length);
+	if (!ok)
+		outStream << "Failed to set resolution (" << deviceID << "):  " << strerror(errno) << std::endl;
+
+	close(resolutionFileDescriptor);
+	return ok;
+}
+
+//==========================================================================
+// Class:			DS18B20
+// Function:		GetResolution
+//
+// Description:		Reads the conversion resolution through the w1-therm driver.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		bits	= unsigned int&
 //
 // Return Value:
 //		bool, true for success, false otherwise
 //
 //==========================================================================
-bool DS18B20::ReadSensor(double &temperature, unsigned int recursion) const
+bool DS18B20::GetResolution(unsigned int& bits) const
 {
-	if (recursion == 0)
+	const int resolutionFileDescriptor(open(resolutionDevice.c_str(), O_RDONLY | O_CLOEXEC));
+	if (resolutionFileDescriptor == -1)
+	{
+		outStream << "Could not open file '" << resolutionDevice << "' for input:  " << strerror(errno) << std::endl;
 		return false;
-		
-	std::ifstream file(device.c_str(), std::ios::in);
-	if (!file.is_open() || !file.good())
+	}
+
+	char data[16];
+	const ssize_t size(read(resolutionFileDescriptor, data, sizeof(data)));
+	close(resolutionFileDescriptor);
+
+	if (size <= 0 || std::from_chars(data, data + size, bits).ec != std::errc() ||
+		bits < minResolution || bits > maxResolution)
+	{
+		outStream << "Failed to read resolution (" << deviceID << ")" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			DS18B20
+// Function:		GetConversionTime
+//
+// Description:		Returns the maximum conversion time for the specified
+//					resolution (750 ms at 12 bits, halving for each bit less).
+//
+// Input Arguments:
+//		bits	= const unsigned int&, 9 to 12
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::chrono::milliseconds
+//
+//==========================================================================
+std::chrono::milliseconds DS18B20::GetConversionTime(const unsigned int& bits)
+{
+	assert(bits >= minResolution && bits <= maxResolution);
+	const std::chrono::microseconds maxConversionTime(750000);
+	return std::chrono::duration_cast<std::chrono::milliseconds>(
+		maxConversionTime / (1 << (maxResolution - bits)) + std::chrono::microseconds(999));// Round up
+}
+
+//==========================================================================
+// Class:			DS18B20
+// Function:		GetConversionTime
+//
+// Description:		Returns the maximum conversion time at this sensor's
+//					current resolution.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::chrono::milliseconds
+//
+//==========================================================================
+std::chrono::milliseconds DS18B20::GetConversionTime() const
+{
+	unsigned int bits;
+	if (!GetResolution(bits))
+		bits = maxResolution;
+
+	return GetConversionTime(bits);
+}
+
+//==========================================================================
+// Class:			DS18B20
+// Function:		OpenDevice
+//
+// Description:		Opens the device file, if it isn't already open.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool DS18B20::OpenDevice() const
+{
+	if (fileDescriptor != -1)
+		return true;
+
+	int newFileDescriptor(open(device.c_str(), O_RDONLY | O_CLOEXEC));
+	if (newFileDescriptor == -1)
 	{
 		outStream << "Could not open file '" << device << "' for input" << std::endl;
-		return ReadSensor(temperature, recursion - 1);
+		return false;
 	}
 
-	std::string data;
-	if (!std::getline(file, data))
+	// Another thread may have beaten us to it
+	int expected(-1);
+	if (!fileDescriptor.compare_exchange_strong(expected, newFileDescriptor))
+		close(newFileDescriptor);
+
+	return true;
+}
+
+//==========================================================================
+// Class:			DS18B20
+// Function:		ReadSensor
+//
+// Description:		Reads current temperature from DS18B20 sensor.  The file
+//					looks like this:
+//					72 01 4b 46 7f ff 0e 10 57 : crc=57 YES
+//					72 01 4b 46 7f ff 0e 10 57 t=23125
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		temperature	= double& [deg C]
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool DS18B20::ReadSensor(double &temperature) const
+{
+	readCount++;
+	if (!OpenDevice())
+		return false;
+
+	char data[256];
+	const ssize_t size(pread(fileDescriptor, data, sizeof(data), 0));
+	if (size <= 0)
 	{
-		outStream << "Failed to read CRC from file '" << device << "'" << std::endl;
-		return ReadSensor(temperature, recursion - 1);
+		outStream << "Failed to read from file '" << device << "'" << std::endl;
+
+		// The device may have been removed and re-added - try a fresh descriptor next time
+		const int oldFileDescriptor(fileDescriptor.exchange(-1));
+		if (oldFileDescriptor != -1)
+			close(oldFileDescriptor);
+		return false;
 	}
 
+	const char* begin(data);
+	const char* end(data + size);
+	const char* lineEnd(std::find(begin, end, '\n'));
+
 	// Line must contain at least "YES" at the end...
-	if (data.length() < 3)
+	if (lineEnd - begin < 3)
 	{
 		outStream << "File contents too short (" << deviceID << ")" << std::endl;
-		return ReadSensor(temperature, recursion - 1);
+		return false;
 	}
 
-	if (data.substr(data.length() - 3).compare("YES") != 0)
+	if (strncmp(lineEnd - 3, "YES", 3) != 0)
 	{
 		// This happens quite often - might want to disable this statement
 		// after testing is complete, to avoid spamming?
 		outStream << "Bad checksum (" << deviceID << ")" << std::endl;
-		return ReadSensor(temperature, recursion - 1);
+		crcFailureCount++;
+		return false;
 	}
 
-	if (!std::getline(file, data))
+	const char* tag("t=");
+	const char* start(std::search(lineEnd, end, tag, tag + 2));
+	if (start == end)
 	{
-		outStream << "Failed to read temperature from file '" << device << "'" << std::endl;
-		return ReadSensor(temperature, recursion - 1);
+		outStream << "Temperature reading does not contain 't='"
+			<< " (" << deviceID << ")" << std::endl;
+		return false;
 	}
 
-	size_t start(data.find("t="));
-	if (start == std::string::npos)
+	int milliDegrees;
+	if (std::from_chars(start + 2, end, milliDegrees).ec != std::errc())
 	{
-		outStream << "Temperature reading does not contain 't='"
-			<< " (" << deviceID << ")" << std::endl;
-		return ReadSensor(temperature, recursion - 1);
+		outStream << "Failed to parse temperature (" << deviceID << ")" << std::endl;
+		return false;
 	}
 
-	temperature = atof(data.substr(start + 2).c_str()) / 1000.0;
+	temperature = milliDegrees / 1000.0;
+	return true;
+}
 
+//==========================================================================
+// Class:			DS18B20
+// Function:		LoadKernelModules
+//
+// Description:		Loads the 1-wire kernel modules, if that hasn't already
+//					been done successfully.  Once loaded, the bus master finds
+//					newly connected sensors on its own.
+//
+// Input Arguments:
+//		outStream	= UString::OStream&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool DS18B20::LoadKernelModules(UString::OStream& outStream)
+{
+	std::lock_guard<std::mutex> lock(initializationMutex);
+	if (initialized)
+		return true;
+
+	int ret(system("modprobe w1-gpio"));
+	if (ret == -1)
+	{
+		outStream << "Failed to mount temperature sensor (modprobe w1-gpio):  " << strerror(errno) << std::endl;
+		return false;
+	}
+	else if (ret == 127)
+	{
+		outStream << "Failed to mount temperature sensor (modprobe w1-gpio) - could not create child process" << std::endl;
+		return false;
+	}
+	
+	ret = system("modprobe w1-therm");
+	if (ret == -1)
+	{
+		outStream << "Failed to mount temperature sensor (modprobe w1-therm):  " << strerror(errno) << std::endl;
+		return false;
+	}
+	else if (ret == 127)
+	{
+		outStream << "Failed to mount temperature sensor (modprobe w1-therm) - could not create child process" << std::endl;
+		return false;
+	}
+	
+	initialized = true;
 	return true;
 }
 
@@ -199,14 +516,11 @@ bool DS18B20::ReadSensor(double &temperature, unsigned int recursion) const
 //==========================================================================
 std::vector<std::string> DS18B20::GetConnectedSensors(std::string searchDirectory)
 {
-	// Assume that this might be called when a new sensor is connected - therefore, don't
-	// use the initialized variable to determine whether or not to make these calls
-	system("modprobe w1-gpio");
-	system("modprobe w1-therm");
+	LoadKernelModules(std::cout);
 
 	std::vector<std::string> deviceList;
 
-	// Initially, populate deviceList with all directories under searchDirectory
+	// Populate deviceList with all DS18B20 directories under searchDirectory
 	DIR *directory = opendir(searchDirectory.c_str());
 	if (!directory)
 	{
@@ -222,23 +536,14 @@ std::vector<std::string> DS18B20::GetConnectedSensors(std::string searchDirector
 		// but it's probably not necessary
 		name = listing->d_name;
 		if (name.length() == 15 &&
-			name[2] == '-')
+			name[2] == '-' &&
+			DS18B20::DeviceIsDS18B20(name))
 			deviceList.push_back(name);
 	}
 
 	if (closedir(directory) == -1)
 		std::cout << "Failed to close directory file" << std::endl;
 
-	unsigned int i;
-	for (i = 0; i < deviceList.size(); i++)
-	{
-		if (!DS18B20::DeviceIsDS18B20(deviceList[i]))
-		{
-			deviceList.erase(deviceList.begin() + i);
-			i--;
-		}
-	}
-
 	return deviceList;
 }
 
@@ -15,6 +15,10 @@
 #include <vector>
 #include <ostream>
 #include <iostream>
+#include <atomic>
+#include <cstdint>
+#include <chrono>
+#include <mutex>
 
 // Local headers
 #include "temperatureSensor.h"
@@ -25,22 +29,58 @@ class DS18B20 : public TemperatureSensor
 public:
 	DS18B20(std::string deviceID, UString::OStream& outStream = Cout,
 		std::string baseDirectory = "/sys/bus/w1/devices/", const unsigned int& allowedRecursions = 3);
+	DS18B20(const DS18B20& sensor);
+	virtual ~DS18B20();
 
 	virtual bool GetTemperature(double &temperature) const;// [deg C]
 
+	struct Statistics
+	{
+		uint64_t reads = 0;// Attempts, including retries
+		uint64_t crcFailures = 0;
+		uint64_t retries = 0;
+		uint64_t failures = 0;// Calls to GetTemperature that gave up
+	};
+
+	Statistics GetStatistics() const;
+	void ResetStatistics();
+
+	// Resolution is 9 to 12 bits; lower resolutions convert faster
+	static const unsigned int minResolution, maxResolution;
+	bool SetResolution(const unsigned int& bits);
+	bool GetResolution(unsigned int& bits) const;
+
+	// Maximum conversion time from the datasheet
+	static std::chrono::milliseconds GetConversionTime(const unsigned int& bits);
+	std::chrono::milliseconds GetConversionTime() const;// Assumes 12 bits if the resolution can't be read
+
 	static std::vector<std::string> GetConnectedSensors(
 		std::string searchDirectory = "/sys/bus/w1/devices/");
 	static bool DeviceIsDS18B20(std::string rom);
 
+	// Called automatically by the constructor and GetConnectedSensors
+	static bool LoadKernelModules(UString::OStream& outStream = Cout);
+
 private:
 	static bool initialized;
+	static std::mutex initializationMutex;
 	static const std::string deviceFile;
+	static const std::string resolutionFile;
 
-	const std::string deviceID, device;
+	const std::string deviceID, device, resolutionDevice;
 	UString::OStream &outStream;
 	const unsigned int allowedRecursions;
 
-	bool ReadSensor(double &temperature, unsigned int recursion) const;// [deg C]
+	// The device file is kept open and re-read from the start for each reading
+	mutable std::atomic<int> fileDescriptor;
+	bool OpenDevice() const;
+
+	mutable std::atomic<uint64_t> readCount;
+	mutable std::atomic<uint64_t> crcFailureCount;
+	mutable std::atomic<uint64_t> retryCount;
+	mutable std::atomic<uint64_t> failureCount;
+
+	bool ReadSensor(double &temperature) const;// [deg C]
 };
 
 #endif// DS18B20_SENSOR_H_
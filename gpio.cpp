@@ -7,17 +7,16 @@
 // Standard C++ headers
 #include <cassert>
 
-// Wiring pi headers
-#include <wiringPi.h>
-
 // Local headers
 #include "gpio.h"
+#include "gpioBackend.h"
+#include "wiringPiGPIOBackend.h"
 
 //==========================================================================
 // Class:			GPIO
 // Function:		None
 //
-// Description:		Static member initializaiton.
+// Description:		Static member initialization.
 //
 // Input Arguments:
 //		None
@@ -29,7 +28,7 @@
 //		None
 //
 //==========================================================================
-bool GPIO::initialized = false;
+GPIOBackend *GPIO::defaultBackend = nullptr;
 
 //==========================================================================
 // Class:			GPIO
@@ -41,6 +40,7 @@ bool GPIO::initialized = false;
 //		pin			= const int&, pin number using Wiring Pi numbering scheme.
 //					  See:  http://wiringpi.com/pins/
 //		direction	= const DataDirection&
+//		backend		= GPIOBackend&, object that performs the pin access
 //
 // Output Arguments:
 //		None
@@ -49,15 +49,10 @@ bool GPIO::initialized = false;
 //		None
 //
 //==========================================================================
-GPIO::GPIO(const int &pin, const DataDirection &direction) : pin(pin)
+GPIO::GPIO(const int &pin, const DataDirection &direction,
+	GPIOBackend &backend) : pin(pin), backend(backend)
 {
-	if (!initialized)
-	{
-		wiringPiSetup();
-		initialized = true;
-	}
-
-	assert(pin >= 0 && pin <= 40);
+	assert(pin >= 0 && pin < GPIOBackend::wiringPiPinCount);
 	SetDataDirection(direction);
 }
 
@@ -80,8 +75,8 @@ GPIO::GPIO(const int &pin, const DataDirection &direction) : pin(pin)
 GPIO::~GPIO()
 {
 	// Turn everything off
-	digitalWrite(pin, 0);
-	pullUpDnControl(pin, PUD_OFF);
+	backend.SetOutput(pin, false);
+	backend.SetPullUpDown(pin, PullResistance::Off);
 }
 
 //==========================================================================
@@ -102,21 +97,14 @@ GPIO::~GPIO()
 //==========================================================================
 void GPIO::SetDataDirection(const DataDirection &direction)
 {
-	assert(direction != DataDirection::PWMOutput || pin == 1);
+	// Hardware PWM is available on pins 1 and 26 (channel 0) and 23 and 24 (channel 1)
+	assert(direction != DataDirection::PWMOutput || pin == 1 || pin == 23 || pin == 24 || pin == 26);
 
 	if (direction == DataDirection::Output)
 		SetPullUpDown(PullResistance::Off);
 
 	this->direction = direction;
-
-	if (direction == DataDirection::Input)
-		pinMode(pin, INPUT);
-	else if (direction == DataDirection::Output)
-		pinMode(pin, OUTPUT);
-	else if (direction == DataDirection::PWMOutput)
-		pinMode(pin, PWM_OUTPUT);
-	else
-		assert(false);
+	backend.SetDataDirection(pin, direction);
 }
 
 //==========================================================================
@@ -138,15 +126,7 @@ void GPIO::SetDataDirection(const DataDirection &direction)
 void GPIO::SetPullUpDown(const PullResistance &state)
 {
 	assert(state == PullResistance::Off || direction == DataDirection::Input);
-
-	if (state == PullResistance::Off)
-		pullUpDnControl(pin, PUD_OFF);
-	else if (state == PullResistance::PullUp)
-		pullUpDnControl(pin, PUD_UP);
-	else if (state == PullResistance::PullDown)
-		pullUpDnControl(pin, PUD_DOWN);
-	else
-		assert(false);
+	backend.SetPullUpDown(pin, state);
 }
 
 //==========================================================================
@@ -169,7 +149,7 @@ void GPIO::SetOutput(const bool &high)
 {
 	assert(direction == DataDirection::Output);
 
-	digitalWrite(pin, high ? 1 : 0);
+	backend.SetOutput(pin, high);
 }
 
 //==========================================================================
@@ -191,5 +171,57 @@ void GPIO::SetOutput(const bool &high)
 bool GPIO::GetInput()
 {
 	assert(direction == DataDirection::Input);
-	return digitalRead(pin) == 1;
+	return backend.GetInput(pin);
+}
+
+//==========================================================================
+// Class:			GPIO
+// Function:		GetDefaultBackend
+//
+// Description:		Returns the backend used when none is specified at
+//					construction.  Unless another backend was selected with
+//					SetDefaultBackend, this is Wiring Pi (initialized on
+//					first use).
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		GPIOBackend&
+//
+//==========================================================================
+GPIOBackend& GPIO::GetDefaultBackend()
+{
+	if (defaultBackend)
+		return *defaultBackend;
+
+	static WiringPiGPIOBackend wiringPiBackend;
+	return wiringPiBackend;
+}
+
+//==========================================================================
+// Class:			GPIO
+// Function:		SetDefaultBackend
+//
+// Description:		Selects the backend used by objects constructed without
+//					one (including those created internally by other classes,
+//					such as PingSensor).  Must be called before any such
+//					objects are created, and the backend must outlive them.
+//
+// Input Arguments:
+//		backend	= GPIOBackend&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void GPIO::SetDefaultBackend(GPIOBackend &backend)
+{
+	defaultBackend = &backend;
 }
@@ -7,6 +7,8 @@
 #ifndef GPIO_H_
 #define GPIO_H_
 
+class GPIOBackend;
+
 class GPIO
 {
 public:
@@ -24,7 +26,8 @@ public:
 		PullDown
 	};
 
-	GPIO(const int &pin, const DataDirection &direction);
+	GPIO(const int &pin, const DataDirection &direction,
+		GPIOBackend &backend = GetDefaultBackend());
 	virtual ~GPIO();
 
 	void SetDataDirection(const DataDirection &direction);
@@ -32,12 +35,18 @@ public:
 	void SetOutput(const bool &high);
 	bool GetInput();
 
+	int GetPin() const { return pin; }
+
+	static GPIOBackend& GetDefaultBackend();
+	static void SetDefaultBackend(GPIOBackend &backend);
+
 protected:
 	const int pin;
+	GPIOBackend &backend;
 
 private:
 	DataDirection direction;
-	static bool initialized;
+	static GPIOBackend *defaultBackend;
 };
 
 
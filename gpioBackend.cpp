@@ -0,0 +1,114 @@
+// File:  gpioBackend.cpp
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  Interface for objects that perform low-level pin access on behalf of
+//        the GPIO and Interrupt classes.
+
+// Standard C++ headers
+#include <cassert>
+
+// Local headers
+#include "gpioBackend.h"
+
+//==========================================================================
+// Class:			GPIOBackend
+// Function:		WiringPiToBCM
+//
+// Description:		Converts a Wiring Pi pin number to the corresponding
+//					Broadcom GPIO number (board revision 2 and later).
+//					See:  http://wiringpi.com/pins/
+//
+// Input Arguments:
+//		pin	= const int&, pin number using Wiring Pi numbering scheme
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		int, Broadcom GPIO number, or -1 if the pin doesn't exist
+//
+//==========================================================================
+int GPIOBackend::WiringPiToBCM(const int &pin)
+{
+	static const int pinToBCM[wiringPiPinCount] = {
+		17, 18, 27, 22, 23, 24, 25, 4,// 0 - 7
+		2, 3, 8, 7, 10, 9, 11, 14,// 8 - 15
+		15, 28, 29, 30, 31, 5, 6, 13,// 16 - 23
+		19, 26, 12, 16, 20, 21, 0, 1// 24 - 31
+	};
+
+	if (pin < 0 || pin >= wiringPiPinCount)
+	{
+		assert(false);
+		return -1;
+	}
+
+	return pinToBCM[pin];
+}
+
+//==========================================================================
+// Class:			GPIOBackend
+// Function:		SetOutputs
+//
+// Description:		Sets the state of several output pins.  This default
+//					implementation writes each pin in turn; backends that
+//					can update many pins at once should override it.
+//
+// Input Arguments:
+//		pins	= const std::vector<int>&
+//		values	= const uint32_t&, bit i is the desired state of pins[i]
+//		mask	= const uint32_t&, only pins with the corresponding bit set
+//				  are changed
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void GPIOBackend::SetOutputs(const std::vector<int> &pins, const uint32_t &values, const uint32_t &mask)
+{
+	assert(pins.size() <= 32);
+
+	unsigned int i;
+	for (i = 0; i < pins.size(); i++)
+	{
+		if (mask & (1u << i))
+			SetOutput(pins[i], (values & (1u << i)) != 0);
+	}
+}
+
+//==========================================================================
+// Class:			GPIOBackend
+// Function:		GetInputs
+//
+// Description:		Reads the state of several input pins.  This default
+//					implementation reads each pin in turn; backends that
+//					can sample many pins at once should override it.
+//
+// Input Arguments:
+//		pins	= const std::vector<int>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		uint32_t, bit i is set if pins[i] is high
+//
+//==========================================================================
+uint32_t GPIOBackend::GetInputs(const std::vector<int> &pins)
+{
+	assert(pins.size() <= 32);
+
+	uint32_t values(0);
+	unsigned int i;
+	for (i = 0; i < pins.size(); i++)
+	{
+		if (GetInput(pins[i]))
+			values |= 1u << i;
+	}
+
+	return values;
+}
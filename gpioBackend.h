@@ -0,0 +1,46 @@
+// File:  gpioBackend.h
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  Interface for objects that perform low-level pin access on behalf of
+//        the GPIO and Interrupt classes.
+
+#ifndef GPIO_BACKEND_H_
+#define GPIO_BACKEND_H_
+
+// Standard C++ headers
+#include <vector>
+#include <cstdint>
+
+// Local headers
+#include "gpio.h"
+#include "interrupt.h"
+
+class GPIOBackend
+{
+public:
+	virtual ~GPIOBackend() {}
+
+	virtual void SetDataDirection(const int &pin, const GPIO::DataDirection &direction) = 0;
+	virtual void SetPullUpDown(const int &pin, const GPIO::PullResistance &state) = 0;
+	virtual void SetOutput(const int &pin, const bool &high) = 0;
+	virtual bool GetInput(const int &pin) = 0;
+
+	// Bit i of values, mask and the returned snapshot corresponds to pins[i]
+	virtual void SetOutputs(const std::vector<int> &pins, const uint32_t &values, const uint32_t &mask);
+	virtual uint32_t GetInputs(const std::vector<int> &pins);
+
+	virtual bool AttachInterrupt(Interrupt &interrupt, const Interrupt::EdgeDirection &edge) = 0;
+	virtual void DetachInterrupt(Interrupt &/*interrupt*/) {}
+
+	// Wiring Pi pins 0 - 31 are valid
+	static const int wiringPiPinCount = 32;
+
+protected:
+	// All pin arguments use the Wiring Pi numbering scheme; backends that
+	// talk to the hardware directly need the Broadcom numbers instead (-1
+	// for pins that don't exist)
+	static int WiringPiToBCM(const int &pin);
+};
+
+#endif// GPIO_BACKEND_H_
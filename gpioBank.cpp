@@ -0,0 +1,155 @@
+// File:  gpioBank.cpp
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  Group of GPIO pins that are written and read together.  Bit i of
+//        every mask or value refers to the i-th pin passed to the constructor.
+
+// Standard C++ headers
+#include <cassert>
+#include <algorithm>
+
+// Local headers
+#include "gpioBank.h"
+#include "gpioBackend.h"
+
+//==========================================================================
+// Class:			GPIOBank
+// Function:		GPIOBank
+//
+// Description:		Constructor for GPIOBank class.  All checks on the pin
+//					set are done here so the per-call methods only need to
+//					hand the masks to the backend.
+//
+// Input Arguments:
+//		pins		= const std::vector<int>&, up to 32 distinct pin numbers
+//					  using Wiring Pi numbering scheme
+//		direction	= const GPIO::DataDirection&, Input or Output
+//		backend		= GPIOBackend&, object that performs the pin access
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+GPIOBank::GPIOBank(const std::vector<int> &pins, const GPIO::DataDirection &direction,
+	GPIOBackend &backend) : pins(pins), direction(direction),
+	allPinsMask(pins.size() >= 32 ? 0xFFFFFFFF : (1u << pins.size()) - 1), backend(backend)
+{
+	assert(!pins.empty() && pins.size() <= 32);
+	assert(direction == GPIO::DataDirection::Input || direction == GPIO::DataDirection::Output);
+
+	std::vector<int> sortedPins(pins);
+	std::sort(sortedPins.begin(), sortedPins.end());
+	assert(std::adjacent_find(sortedPins.begin(), sortedPins.end()) == sortedPins.end());
+
+	unsigned int i;
+	for (i = 0; i < pins.size(); i++)
+	{
+		assert(pins[i] >= 0 && pins[i] < GPIOBackend::wiringPiPinCount);
+		if (direction == GPIO::DataDirection::Output)
+			backend.SetPullUpDown(pins[i], GPIO::PullResistance::Off);
+		backend.SetDataDirection(pins[i], direction);
+	}
+}
+
+//==========================================================================
+// Class:			GPIOBank
+// Function:		~GPIOBank
+//
+// Description:		Destructor for GPIOBank class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+GPIOBank::~GPIOBank()
+{
+	// Turn everything off
+	backend.SetOutputs(pins, 0, allPinsMask);
+
+	unsigned int i;
+	for (i = 0; i < pins.size(); i++)
+		backend.SetPullUpDown(pins[i], GPIO::PullResistance::Off);
+}
+
+//==========================================================================
+// Class:			GPIOBank
+// Function:		SetPullUpDown
+//
+// Description:		Sets the state of the optional internal pull-up/pull-down
+//					resistors for every pin in the bank.
+//
+// Input Arguments:
+//		state	= const GPIO::PullResistance&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void GPIOBank::SetPullUpDown(const GPIO::PullResistance &state)
+{
+	assert(state == GPIO::PullResistance::Off || direction == GPIO::DataDirection::Input);
+
+	unsigned int i;
+	for (i = 0; i < pins.size(); i++)
+		backend.SetPullUpDown(pins[i], state);
+}
+
+//==========================================================================
+// Class:			GPIOBank
+// Function:		SetOutputs
+//
+// Description:		Sets the state of the selected output pins in as few
+//					register writes as the backend allows.
+//
+// Input Arguments:
+//		values	= const uint32_t&, bit i is the desired state of pin i
+//		mask	= const uint32_t&, only pins with the corresponding bit set
+//				  are changed
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void GPIOBank::SetOutputs(const uint32_t &values, const uint32_t &mask)
+{
+	assert(direction == GPIO::DataDirection::Output);
+	backend.SetOutputs(pins, values, mask & allPinsMask);
+}
+
+//==========================================================================
+// Class:			GPIOBank
+// Function:		GetInputs
+//
+// Description:		Returns a snapshot of all input levels.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		uint32_t, bit i is set if pin i is high
+//
+//==========================================================================
+uint32_t GPIOBank::GetInputs()
+{
+	assert(direction == GPIO::DataDirection::Input);
+	return backend.GetInputs(pins);
+}
@@ -0,0 +1,43 @@
+// File:  gpioBank.h
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  Group of GPIO pins that are written and read together.  Bit i of
+//        every mask or value refers to the i-th pin passed to the constructor.
+
+#ifndef GPIO_BANK_H_
+#define GPIO_BANK_H_
+
+// Standard C++ headers
+#include <vector>
+#include <cstdint>
+
+// Local headers
+#include "gpio.h"
+
+class GPIOBank
+{
+public:
+	GPIOBank(const std::vector<int> &pins, const GPIO::DataDirection &direction,
+		GPIOBackend &backend = GPIO::GetDefaultBackend());
+	virtual ~GPIOBank();
+
+	void SetPullUpDown(const GPIO::PullResistance &state);
+
+	void SetOutputs(const uint32_t &values, const uint32_t &mask);
+	void SetOutputs(const uint32_t &values) { SetOutputs(values, allPinsMask); }
+	void SetHigh(const uint32_t &mask) { SetOutputs(mask, mask); }
+	void SetLow(const uint32_t &mask) { SetOutputs(0, mask); }
+
+	uint32_t GetInputs();
+
+	unsigned int GetPinCount() const { return pins.size(); }
+
+private:
+	const std::vector<int> pins;
+	const GPIO::DataDirection direction;
+	const uint32_t allPinsMask;
+	GPIOBackend &backend;
+};
+
+#endif// GPIO_BANK_H_
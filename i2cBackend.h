@@ -0,0 +1,45 @@
+// File:  i2cBackend.h
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Desc:  Interface for objects that perform bus access on behalf of the TWI
+//        class.  Methods mirror the underlying system calls:  failures return
+//        -1 (or false) and leave the reason in errno.
+
+#ifndef I2C_BACKEND_H_
+#define I2C_BACKEND_H_
+
+// Standard C++ headers
+#include <string>
+#include <cstddef>
+
+class I2CBackend
+{
+public:
+	virtual ~I2CBackend() {}
+
+	virtual int Open(const std::string& deviceFileName) = 0;
+	virtual void Close(const int& handle) = 0;
+
+	virtual bool SelectSlave(const int& handle, const unsigned char& address) = 0;
+	virtual int Write(const int& handle, const unsigned char* data, const size_t& size) = 0;
+	virtual int Read(const int& handle, unsigned char* data, const size_t& size) = 0;
+
+	// One part of a combined transaction (mirrors the kernel's struct i2c_msg)
+	struct Message
+	{
+		unsigned char address;
+		bool read;
+		unsigned char* data;
+		size_t size;
+	};
+
+	// Performs all of the messages as a single transaction, with a repeated
+	// start (rather than a stop) between messages.  Independent of the
+	// slave selected with SelectSlave.
+	virtual bool Transfer(const int& handle, Message* messages, const size_t& count) = 0;
+
+	static const size_t maxTransferMessages = 42;// Limits imposed by i2c-dev
+	static const size_t maxTransferSize = 8192;// [bytes] per read, write or message
+};
+
+#endif// I2C_BACKEND_H_
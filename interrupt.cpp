@@ -7,11 +7,9 @@
 // Standard C++ headers
 #include <cassert>
 
-// Wiring pi headers
-#include <wiringPi.h>
-
 // rpi headers
 #include "interrupt.h"
+#include "gpioBackend.h"
 
 //==========================================================================
 // Class:			Interrupt
@@ -24,6 +22,7 @@
 //				  See:  http://wiringpi.com/pins/
 //		isr		= const InterruptServiceRoutine
 //		edge	= const EdgeDirection&
+//		backend	= GPIOBackend&, object that performs the pin access
 //
 // Output Arguments:
 //		None
@@ -33,19 +32,202 @@
 //
 //==========================================================================
 Interrupt::Interrupt(const int &pin, const InterruptServiceRoutine isr,
-	const EdgeDirection &edge) : GPIO(pin, DataDirection::Input), isr(isr)
-{
-	int edgeFlag;
-	if (edge == EdgeDirection::Rising)
-		edgeFlag = INT_EDGE_RISING;
-	else if (edge == EdgeDirection::Falling)
-		edgeFlag = INT_EDGE_FALLING;
-	else if (edge == EdgeDirection::Both)
-		edgeFlag = INT_EDGE_BOTH;
-	else if (edge == EdgeDirection::Preconfigured)
-		edgeFlag = INT_EDGE_SETUP;
-	else
-		assert(false);
-
-	wiringPiISR(pin, edgeFlag, isr);// TODO:  Expect 0 for success; anything else is a failure
+	const EdgeDirection &edge, GPIOBackend &backend)
+	: GPIO(pin, DataDirection::Input, backend), isr(isr), lastEdgeTime(0), overrunCount(0),
+	waiterCount(0)
+{
+	attached = backend.AttachInterrupt(*this, edge);
+}
+
+//==========================================================================
+// Class:			Interrupt
+// Function:		Interrupt
+//
+// Description:		Constructor for Interrupt class (event-queue mode).  The
+//					queue is allocated here; edges that arrive while it is
+//					full are counted and discarded.
+//
+// Input Arguments:
+//		pin			= const int&, pin number using Wiring Pi numbering scheme.
+//					  See:  http://wiringpi.com/pins/
+//		queueSize	= const size_t&, minimum number of events to hold
+//		edge		= const EdgeDirection&
+//		backend		= GPIOBackend&, object that performs the pin access
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+Interrupt::Interrupt(const int &pin, const size_t &queueSize,
+	const EdgeDirection &edge, GPIOBackend &backend)
+	: GPIO(pin, DataDirection::Input, backend), isr(nullptr), lastEdgeTime(0),
+	eventQueue(new SPSCRingBuffer<EdgeEvent>(queueSize)), overrunCount(0),
+	waiterCount(0)
+{
+	attached = backend.AttachInterrupt(*this, edge);
+}
+
+//==========================================================================
+// Class:			Interrupt
+// Function:		~Interrupt
+//
+// Description:		Destructor for Interrupt class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+Interrupt::~Interrupt()
+{
+	if (attached)
+		backend.DetachInterrupt(*this);
+}
+
+//==========================================================================
+// Class:			Interrupt
+// Function:		HandleEdge
+//
+// Description:		Records the edge and either queues it or calls the
+//					service routine.
+//
+// Input Arguments:
+//		rising	= const bool&, true if the pin went high
+//		time	= const Clock::time_point&, time at which the edge was detected
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void Interrupt::HandleEdge(const bool &rising, const Clock::time_point &time)
+{
+	lastEdgeTime = time.time_since_epoch().count();
+
+	if (eventQueue)
+	{
+		const EdgeEvent event = {pin, rising, time};
+		if (!eventQueue->Push(event))
+			overrunCount++;
+
+		// Only take the lock if a consumer is blocked in WaitForEvents
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (waiterCount > 0)
+		{
+			{
+				std::lock_guard<std::mutex> lock(waitMutex);
+			}
+			eventAvailable.notify_all();
+		}
+	}
+	else if (isr)
+		isr();
+}
+
+//==========================================================================
+// Class:			Interrupt
+// Function:		GetLastEdgeTime
+//
+// Description:		Returns the time of the most recent edge.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Clock::time_point
+//
+//==========================================================================
+Interrupt::Clock::time_point Interrupt::GetLastEdgeTime() const
+{
+	return Clock::time_point(Clock::duration(lastEdgeTime.load()));
+}
+
+//==========================================================================
+// Class:			Interrupt
+// Function:		GetEvents
+//
+// Description:		Removes queued edge events, oldest first.
+//
+// Input Arguments:
+//		maxEvents	= const size_t&
+//
+// Output Arguments:
+//		events		= EdgeEvent*, must have room for maxEvents events
+//
+// Return Value:
+//		size_t, number of events returned
+//
+//==========================================================================
+size_t Interrupt::GetEvents(EdgeEvent *events, const size_t &maxEvents)
+{
+	assert(eventQueue);
+	return eventQueue->Pop(events, maxEvents);
+}
+
+//==========================================================================
+// Class:			Interrupt
+// Function:		GetPendingEventCount
+//
+// Description:		Returns the number of queued edge events.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		size_t
+//
+//==========================================================================
+size_t Interrupt::GetPendingEventCount() const
+{
+	assert(eventQueue);
+	return eventQueue->GetSize();
+}
+
+//==========================================================================
+// Class:			Interrupt
+// Function:		WaitForEvents
+//
+// Description:		Blocks until at least one edge event is queued or the
+//					deadline passes.  Call only from the consumer thread.
+//
+// Input Arguments:
+//		deadline	= const Clock::time_point&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if events are available, false on timeout
+//
+//==========================================================================
+bool Interrupt::WaitForEvents(const Clock::time_point &deadline)
+{
+	assert(eventQueue);
+
+	std::unique_lock<std::mutex> lock(waitMutex);
+	waiterCount++;
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	const bool available(eventAvailable.wait_until(lock, deadline, [this]()
+	{
+		return eventQueue->GetSize() > 0;
+	}));
+	waiterCount--;
+
+	return available;
 }
@@ -7,8 +7,17 @@
 #ifndef INTERRUPT_H_
 #define INTERRUPT_H_
 
+// Standard C++ headers
+#include <chrono>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
 // Local headers
 #include "gpio.h"
+#include "spscRingBuffer.h"
 
 class Interrupt : public GPIO
 {
@@ -22,13 +31,52 @@ public:
 	};
 
 	typedef void (*InterruptServiceRoutine)();
+	typedef std::chrono::steady_clock Clock;
+
+	struct EdgeEvent
+	{
+		int pin;
+		bool level;// Level after the edge (true for rising)
+		Clock::time_point time;
+	};
 
 	Interrupt(const int &pin, const InterruptServiceRoutine isr,
-		const EdgeDirection &edge = EdgeDirection::Rising);
-	virtual ~Interrupt() {}
+		const EdgeDirection &edge = EdgeDirection::Rising,
+		GPIOBackend &backend = GetDefaultBackend());
+
+	// Event-queue mode:  edges are stored for the consumer to collect with
+	// GetEvents instead of calling a service routine
+	Interrupt(const int &pin, const size_t &queueSize,
+		const EdgeDirection &edge = EdgeDirection::Both,
+		GPIOBackend &backend = GetDefaultBackend());
+
+	virtual ~Interrupt();
+
+	bool IsAttached() const { return attached; }
+	InterruptServiceRoutine GetServiceRoutine() const { return isr; }
+
+	Clock::time_point GetLastEdgeTime() const;
+
+	// Event-queue mode only; call from a single consumer thread
+	size_t GetEvents(EdgeEvent *events, const size_t &maxEvents);
+	size_t GetPendingEventCount() const;
+	bool WaitForEvents(const Clock::time_point &deadline);// Returns false on timeout
+	uint64_t GetOverrunCount() const { return overrunCount; }
+
+	// Called by the backend from its event thread
+	void HandleEdge(const bool &rising, const Clock::time_point &time);
 
 private:
 	const InterruptServiceRoutine isr;
+	bool attached;
+	std::atomic<Clock::rep> lastEdgeTime;
+
+	std::unique_ptr<SPSCRingBuffer<EdgeEvent>> eventQueue;
+	std::atomic<uint64_t> overrunCount;
+
+	std::atomic<unsigned int> waiterCount;
+	std::mutex waitMutex;
+	std::condition_variable eventAvailable;
 };
 
 
@@ -0,0 +1,661 @@
+// File:  interruptEventLoop.cpp
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  GPIO backend that services the interrupts of any number of pins from
+//        one epoll descriptor with a small, fixed pool of threads (one by
+//        default), instead of the thread per pin that Wiring Pi creates.  Pin
+//        access is forwarded to another backend.  Edges are detected through
+//        GPIO character device (uAPI v2) line requests, with kernel
+//        timestamps.
+
+// Standard C/C++ headers
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+// *nix standard headers
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+// Linux headers
+#include <linux/gpio.h>
+
+// Local headers
+#include "interruptEventLoop.h"
+
+//==========================================================================
+// Class:			InterruptEventLoop
+// Function:		InterruptEventLoop
+//
+// Description:		Constructor for InterruptEventLoop class.
+//
+// Input Arguments:
+//		pinBackend		= GPIOBackend&, used for everything except interrupts
+//		threadCount		= const unsigned int&, number of dispatch threads
+//		outStream		= std::ostream&
+//		chipFileName	= const std::string&, GPIO chip with the interrupt lines
+//		consumer		= const std::string&, label attached to requested lines
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+InterruptEventLoop::InterruptEventLoop(GPIOBackend &pinBackend, const unsigned int &threadCount,
+	std::ostream &outStream, const std::string &chipFileName, const std::string &consumer)
+	: pinBackend(pinBackend), threadCount(threadCount), outStream(outStream), consumer(consumer),
+	nextSourceID(1), epollFileDescriptor(-1), wakeFileDescriptor(-1), stopThreads(false)
+{
+	assert(threadCount > 0);
+
+	chipFileDescriptor = open(chipFileName.c_str(), O_RDWR | O_CLOEXEC);
+	if (chipFileDescriptor == -1)
+	{
+		outStream << "Failed to open '" << chipFileName << "':  " << strerror(errno) << std::endl;
+		return;
+	}
+
+	epollFileDescriptor = epoll_create1(EPOLL_CLOEXEC);
+	wakeFileDescriptor = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (epollFileDescriptor == -1 || wakeFileDescriptor == -1)
+	{
+		outStream << "Failed to create event descriptors:  " << strerror(errno) << std::endl;
+		return;
+	}
+
+	// Never read, so once written it wakes every thread (ID zero is reserved for it)
+	epoll_event event;
+	memset(&event, 0, sizeof(event));
+	event.events = EPOLLIN;
+	event.data.u64 = 0;
+	if (epoll_ctl(epollFileDescriptor, EPOLL_CTL_ADD, wakeFileDescriptor, &event) == -1)
+		outStream << "Failed to register wake descriptor:  " << strerror(errno) << std::endl;
+}
+
+//==========================================================================
+// Class:			InterruptEventLoop
+// Function:		~InterruptEventLoop
+//
+// Description:		Destructor for InterruptEventLoop class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+InterruptEventLoop::~InterruptEventLoop()
+{
+	if (!threads.empty())
+	{
+		stopThreads = true;
+		const uint64_t wake(1);
+		if (write(wakeFileDescriptor, &wake, sizeof(wake)) != sizeof(wake))
+			outStream << "Failed to wake dispatch threads:  " << strerror(errno) << std::endl;
+
+		for (auto& thread : threads)
+			thread.join();
+	}
+
+	for (const auto& source : sources)
+		close(source.second->requestFileDescriptor);
+
+	if (wakeFileDescriptor != -1)
+		close(wakeFileDescriptor);
+	if (epollFileDescriptor != -1)
+		close(epollFileDescriptor);
+	if (chipFileDescriptor != -1)
+		close(chipFileDescriptor);
+}
+
+//==========================================================================
+// Class:			InterruptEventLoop
+// Function:		SetDataDirection
+//
+// Description:		Passes the call to the pin backend.
+//
+// Input Arguments:
+//		pin			= const int&
+//		direction	= const GPIO::DataDirection&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void InterruptEventLoop::SetDataDirection(const int &pin, const GPIO::DataDirection &direction)
+{
+	pinBackend.SetDataDirection(pin, direction);
+}
+
+//==========================================================================
+// Class:			InterruptEventLoop
+// Function:		SetPullUpDown
+//
+// Description:		Passes the call to the pin backend.
+//
+// Input Arguments:
+//		pin		= const int&
+//		state	= const GPIO::PullResistance&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void InterruptEventLoop::SetPullUpDown(const int &pin, const GPIO::PullResistance &state)
+{
+	pinBackend.SetPullUpDown(pin, state);
+}
+
+//==========================================================================
+// Class:			InterruptEventLoop
+// Function:		SetOutput
+//
+// Description:		Passes the call to the pin backend.
+//
+// Input Arguments:
+//		pin		= const int&
+//		high	= const bool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void InterruptEventLoop::SetOutput(const int &pin, const bool &high)
+{
+	pinBackend.SetOutput(pin, high);
+}
+
+//==========================================================================
+// Class:			InterruptEventLoop
+// Function:		GetInput
+//
+// Description:		Passes the call to the pin backend.
+//
+// Input Arguments:
+//		pin	= const int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool InterruptEventLoop::GetInput(const int &pin)
+{
+	return pinBackend.GetInput(pin);
+}
+
+//==========================================================================
+// Class:			InterruptEventLoop
+// Function:		SetOutputs
+//
+// Description:		Passes the call to the pin backend.
+//
+// Input Arguments:
+//		pins	= const std::vector<int>&
+//		values	= const uint32_t&
+//		mask	= const uint32_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void InterruptEventLoop::SetOutputs(const std::vector<int> &pins, const uint32_t &values, const uint32_t &mask)
+{
+	pinBackend.SetOutputs(pins, values, mask);
+}
+
+//==========================================================================
+// Class:			InterruptEventLoop
+// Function:		GetInputs
+//
+// Description:		Passes the call to the pin backend.
+//
+// Input Arguments:
+//		pins	= const std::vector<int>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		uint32_t
+//
+//==========================================================================
+uint32_t InterruptEventLoop::GetInputs(const std::vector<int> &pins)
+{
+	return pinBackend.GetInputs(pins);
+}
+
+//==========================================================================
+// Class:			InterruptEventLoop
+// Function:		AttachInterrupt
+//
+// Description:		Requests the interrupt's line from the GPIO chip with edge
+//					detection enabled and adds the line request to the epoll
+//					set.  The dispatch threads are started with the first
+//					interrupt.
+//
+// Input Arguments:
+//		interrupt	= Interrupt&
+//		edge		= const Interrupt::EdgeDirection&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool InterruptEventLoop::AttachInterrupt(Interrupt &interrupt, const Interrupt::EdgeDirection &edge)
+{
+	assert(LoopOK());
+
+	uint64_t edgeFlags;
+	if (edge == Interrupt::EdgeDirection::Rising)
+		edgeFlags = GPIO_V2_LINE_FLAG_EDGE_RISING;
+	else if (edge == Interrupt::EdgeDirection::Falling)
+		edgeFlags = GPIO_V2_LINE_FLAG_EDGE_FALLING;
+	else if (edge == Interrupt::EdgeDirection::Both ||
+		edge == Interrupt::EdgeDirection::Preconfigured)// Nothing to inherit from outside the request
+		edgeFlags = GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING;
+	else
+	{
+		assert(false);
+		return false;
+	}
+
+	const int offset(WiringPiToBCM(interrupt.GetPin()));
+	if (offset < 0)
+		return false;
+
+	gpio_v2_line_request request;
+	memset(&request, 0, sizeof(request));
+	request.offsets[0] = offset;
+	request.num_lines = 1;
+	request.config.flags = GPIO_V2_LINE_FLAG_INPUT | edgeFlags;
+	strncpy(request.consumer, consumer.c_str(), GPIO_MAX_NAME_SIZE - 1);
+	if (ioctl(chipFileDescriptor, GPIO_V2_GET_LINE_IOCTL, &request) == -1)
+	{
+		outStream << "Failed to request line " << offset << " for pin " << interrupt.GetPin()
+			<< ":  " << strerror(errno) << std::endl;
+		if (errno == EBUSY)
+			outStream << "The line belongs to another consumer (a CharacterDeviceGPIOBackend can't be"
+				" used as the pin backend for the same pins - attach its interrupts directly)" << std::endl;
+		return false;
+	}
+
+	// Events are drained until the read would block
+	fcntl(request.fd, F_SETFL, fcntl(request.fd, F_GETFL) | O_NONBLOCK);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	for (const auto& source : sources)
+	{
+		if (source.second->interrupt->GetPin() == interrupt.GetPin())
+		{
+			outStream << "Pin " << interrupt.GetPin() << " already has an interrupt attached" << std::endl;
+			close(request.fd);
+			return false;
+		}
+	}
+
+	std::unique_ptr<Source> source(new Source);
+	source->interrupt = &interrupt;
+	source->requestFileDescriptor = request.fd;
+	source->detached = false;
+
+	auto priority(priorities.find(interrupt.GetPin()));
+	if (priority == priorities.end())
+		source->priority = 0;
+	else
+		source->priority = priority->second;
+
+	const uint64_t sourceID(nextSourceID++);
+	epoll_event event;
+	memset(&event, 0, sizeof(event));
+	event.events = EPOLLIN | EPOLLONESHOT;
+	event.data.u64 = sourceID;
+	if (epoll_ctl(epollFileDescriptor, EPOLL_CTL_ADD, request.fd, &event) == -1)
+	{
+		outStream << "Failed to register line " << offset << ":  " << strerror(errno) << std::endl;
+		close(request.fd);
+		return false;
+	}
+
+	sources[sourceID] = std::move(source);
+
+	while (threads.size() < threadCount)
+		threads.push_back(std::thread(&InterruptEventLoop::ThreadEntry, this));
+
+	return true;
+}
+
+//==========================================================================
+// Class:			InterruptEventLoop
+// Function:		DetachInterrupt
+//
+// Description:		Removes the interrupt's line from the epoll set and
+//					releases it.  Once this returns, the interrupt will not be
+//					called again.  If a dispatch thread is calling the
+//					interrupt, waits for it to return.  When called from a
+//					dispatch thread (i.e. from within an interrupt), the
+//					removal is completed by that thread after the current
+//					interrupt returns, instead of waiting.
+//
+// Input Arguments:
+//		interrupt	= Interrupt&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void InterruptEventLoop::DetachInterrupt(Interrupt &interrupt)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	auto source(sources.begin());
+	while (source != sources.end() &&
+		(source->second->interrupt != &interrupt || source->second->detached))
+		++source;
+
+	if (source == sources.end())
+		return;
+
+	Source& s(*source->second);
+	if (epoll_ctl(epollFileDescriptor, EPOLL_CTL_DEL, s.requestFileDescriptor, nullptr) == -1)
+		outStream << "Failed to unregister pin " << interrupt.GetPin() << ":  " << strerror(errno) << std::endl;
+
+	s.detached = true;
+	if (s.dispatchThread == std::this_thread::get_id())
+		return;
+
+	// The dispatch thread may remove the source itself
+	const uint64_t sourceID(source->first);
+	dispatchComplete.wait(lock, [this, sourceID]()
+	{
+		auto source(sources.find(sourceID));
+		return source == sources.end() || source->second->dispatchThread == std::thread::id();
+	});
+
+	RemoveSource(sourceID);
+}
+
+//==========================================================================
+// Class:			InterruptEventLoop
+// Function:		SetPriority
+//
+// Description:		Sets the dispatch priority for the specified pin.
+//
+// Input Arguments:
+//		pin			= const int&
+//		priority	= const int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void InterruptEventLoop::SetPriority(const int &pin, const int &priority)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	priorities[pin] = priority;
+	for (auto& source : sources)
+	{
+		if (source.second->interrupt->GetPin() == pin)
+			source.second->priority = priority;
+	}
+}
+
+//==========================================================================
+// Class:			InterruptEventLoop
+// Function:		GetStatistics
+//
+// Description:		Returns a copy of the dispatch statistics.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Statistics
+//
+//==========================================================================
+InterruptEventLoop::Statistics InterruptEventLoop::GetStatistics() const
+{
+	std::lock_guard<std::mutex> lock(statisticsMutex);
+	return statistics;
+}
+
+//==========================================================================
+// Class:			InterruptEventLoop
+// Function:		ResetStatistics
+//
+// Description:		Clears the dispatch statistics.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void InterruptEventLoop::ResetStatistics()
+{
+	std::lock_guard<std::mutex> lock(statisticsMutex);
+	statistics = Statistics();
+}
+
+//==========================================================================
+// Class:			InterruptEventLoop
+// Function:		ThreadEntry
+//
+// Description:		Entry point for the dispatch threads.  Each ready line is
+//					disarmed (EPOLLONESHOT) until its dispatch completes, so
+//					one line is never serviced by two threads at once.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void InterruptEventLoop::ThreadEntry()
+{
+	// Room for every source (at most one per pin) plus the wake descriptor, so
+	// all ready pins are collected by one epoll_wait and sorted by priority
+	// together
+	const unsigned int maxEvents(GPIOBackend::wiringPiPinCount + 1);
+	epoll_event events[maxEvents];
+	std::pair<int, uint64_t> ready[maxEvents];// priority, source ID
+
+	while (!stopThreads)
+	{
+		const int count(epoll_wait(epollFileDescriptor, events, maxEvents, -1));
+		if (count == -1)
+		{
+			if (errno == EINTR)
+				continue;
+
+			outStream << "Failed to wait for pin events:  " << strerror(errno) << std::endl;
+			return;
+		}
+
+		unsigned int readyCount(0);
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			int i;
+			for (i = 0; i < count; i++)
+			{
+				auto source(sources.find(events[i].data.u64));
+				if (source == sources.end() || source->second->detached)
+					continue;
+
+				source->second->dispatchThread = std::this_thread::get_id();
+				ready[readyCount++] = std::make_pair(source->second->priority, source->first);
+			}
+		}
+
+		std::stable_sort(ready, ready + readyCount, [](const std::pair<int, uint64_t>& a, const std::pair<int, uint64_t>& b)
+		{
+			return a.first > b.first;
+		});
+
+		Interrupt::Clock::duration totalLatency(Interrupt::Clock::duration::zero());
+		Interrupt::Clock::duration maxLatency(Interrupt::Clock::duration::zero());
+		unsigned int i;
+		for (i = 0; i < readyCount; i++)
+		{
+			Interrupt::Clock::duration latency;
+			Dispatch(ready[i].second, latency);
+			totalLatency += latency;
+			maxLatency = std::max(maxLatency, latency);
+		}
+
+		std::lock_guard<std::mutex> lock(statisticsMutex);
+		statistics.wakeCount++;
+		statistics.dispatchCount += readyCount;
+		statistics.totalLatency += totalLatency;
+		statistics.maxLatency = std::max(statistics.maxLatency, maxLatency);
+	}
+}
+
+//==========================================================================
+// Class:			InterruptEventLoop
+// Function:		Dispatch
+//
+// Description:		Passes each pending edge (with its kernel timestamp) to
+//					the source's interrupt, then re-arms the source, or
+//					removes it if it was detached in the meantime.
+//
+// Input Arguments:
+//		sourceID	= const uint64_t&
+//
+// Output Arguments:
+//		latency		= Interrupt::Clock::duration&, from the first edge (kernel
+//					  timestamp) to its service routine being called
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void InterruptEventLoop::Dispatch(const uint64_t &sourceID, Interrupt::Clock::duration &latency)
+{
+	// While dispatchThread is set, the source cannot be removed by another thread
+	std::unique_lock<std::mutex> lock(mutex);
+	Source *source(sources.at(sourceID).get());
+
+	latency = Interrupt::Clock::duration::zero();
+	bool first(true);
+
+	const unsigned int bufferSize(16);
+	gpio_v2_line_event events[bufferSize];
+	ssize_t readSize(0);
+	while (!source->detached &&
+		(readSize = read(source->requestFileDescriptor, events, sizeof(events)), readSize > 0))
+	{
+		const unsigned int count(readSize / sizeof(gpio_v2_line_event));
+		unsigned int i;
+		for (i = 0; i < count && !source->detached; i++)
+		{
+			const Interrupt::Clock::time_point time(std::chrono::duration_cast<Interrupt::Clock::duration>(
+				std::chrono::nanoseconds(events[i].timestamp_ns)));
+			// Line events are timestamped with CLOCK_MONOTONIC, like steady_clock
+			if (first)
+			{
+				latency = Interrupt::Clock::now() - time;
+				first = false;
+			}
+
+			lock.unlock();
+			source->interrupt->HandleEdge(events[i].id == GPIO_V2_LINE_EVENT_RISING_EDGE, time);
+			lock.lock();
+		}
+	}
+
+	if (readSize == -1 && errno != EAGAIN)
+		outStream << "Failed to read events for pin " << source->interrupt->GetPin()
+			<< ":  " << strerror(errno) << std::endl;
+
+	source->dispatchThread = std::thread::id();
+	if (source->detached)
+	{
+		RemoveSource(sourceID);
+		dispatchComplete.notify_all();
+		return;
+	}
+
+	epoll_event event;
+	memset(&event, 0, sizeof(event));
+	event.events = EPOLLIN | EPOLLONESHOT;
+	event.data.u64 = sourceID;
+	if (epoll_ctl(epollFileDescriptor, EPOLL_CTL_MOD, source->requestFileDescriptor, &event) == -1)
+		outStream << "Failed to re-arm pin " << source->interrupt->GetPin() << ":  " << strerror(errno) << std::endl;
+
+	dispatchComplete.notify_all();
+}
+
+//==========================================================================
+// Class:			InterruptEventLoop
+// Function:		RemoveSource
+//
+// Description:		Releases the source's line and forgets the source.  Caller
+//					must hold the lock, and the source must not be in the
+//					epoll set or being dispatched.
+//
+// Input Arguments:
+//		sourceID	= const uint64_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void InterruptEventLoop::RemoveSource(const uint64_t &sourceID)
+{
+	auto source(sources.find(sourceID));
+	if (source == sources.end())
+		return;
+
+	close(source->second->requestFileDescriptor);
+	sources.erase(source);
+}
@@ -0,0 +1,106 @@
+// File:  interruptEventLoop.h
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  GPIO backend that services the interrupts of any number of pins from
+//        one epoll descriptor with a small, fixed pool of threads (one by
+//        default), instead of the thread per pin that Wiring Pi creates.  Pin
+//        access is forwarded to another backend.  Edges are detected through
+//        GPIO character device (uAPI v2) line requests, with kernel
+//        timestamps.
+
+#ifndef INTERRUPT_EVENT_LOOP_H_
+#define INTERRUPT_EVENT_LOOP_H_
+
+// Standard C++ headers
+#include <string>
+#include <iostream>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+
+// Local headers
+#include "gpioBackend.h"
+
+class InterruptEventLoop : public GPIOBackend
+{
+public:
+	InterruptEventLoop(GPIOBackend &pinBackend = GPIO::GetDefaultBackend(),
+		const unsigned int &threadCount = 1, std::ostream &outStream = std::cout,
+		const std::string &chipFileName = "/dev/gpiochip0", const std::string &consumer = "rpi");
+	virtual ~InterruptEventLoop();
+
+	// Pin access is passed through to pinBackend
+	virtual void SetDataDirection(const int &pin, const GPIO::DataDirection &direction);
+	virtual void SetPullUpDown(const int &pin, const GPIO::PullResistance &state);
+	virtual void SetOutput(const int &pin, const bool &high);
+	virtual bool GetInput(const int &pin);
+	virtual void SetOutputs(const std::vector<int> &pins, const uint32_t &values, const uint32_t &mask);
+	virtual uint32_t GetInputs(const std::vector<int> &pins);
+
+	virtual bool AttachInterrupt(Interrupt &interrupt, const Interrupt::EdgeDirection &edge);
+	virtual void DetachInterrupt(Interrupt &interrupt);
+
+	// When several pins are ready at once, higher priorities are serviced
+	// first (default is zero).  With more than one thread, the ready pins are
+	// shared among the threads, so the order only holds within each thread.
+	void SetPriority(const int &pin, const int &priority);
+
+	bool LoopOK() const { return chipFileDescriptor != -1 && epollFileDescriptor != -1 && wakeFileDescriptor != -1; }
+
+	struct Statistics
+	{
+		uint64_t wakeCount = 0;
+		uint64_t dispatchCount = 0;
+		// Time from the edge (kernel timestamp) to the interrupt being called,
+		// including wake-up and scheduling delays
+		Interrupt::Clock::duration totalLatency = Interrupt::Clock::duration::zero();
+		Interrupt::Clock::duration maxLatency = Interrupt::Clock::duration::zero();
+	};
+
+	Statistics GetStatistics() const;
+	void ResetStatistics();
+
+private:
+	GPIOBackend &pinBackend;
+	const unsigned int threadCount;
+	std::ostream &outStream;
+	const std::string consumer;
+	int chipFileDescriptor;
+
+	struct Source
+	{
+		Interrupt *interrupt;
+		int requestFileDescriptor;// Line request for this pin only
+		int priority;
+		std::thread::id dispatchThread;// Default-constructed when not being dispatched
+		bool detached;// Removal deferred until the dispatch completes
+	};
+
+	// Keyed by an identifier that is never reused, so a stale event for a
+	// detached source cannot be mistaken for an event on a new one
+	std::map<uint64_t, std::unique_ptr<Source>> sources;
+	std::map<int, int> priorities;
+	uint64_t nextSourceID;
+	std::mutex mutex;
+	std::condition_variable dispatchComplete;
+
+	int epollFileDescriptor;
+	int wakeFileDescriptor;
+	std::vector<std::thread> threads;
+	std::atomic<bool> stopThreads;
+
+	mutable std::mutex statisticsMutex;
+	Statistics statistics;
+
+	void ThreadEntry();
+	void Dispatch(const uint64_t &sourceID, Interrupt::Clock::duration &latency);
+	void RemoveSource(const uint64_t &sourceID);
+};
+
+#endif// INTERRUPT_EVENT_LOOP_H_
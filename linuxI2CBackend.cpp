@@ -0,0 +1,63 @@
+// File:  linuxI2CBackend.cpp
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Desc:  I2C backend using the Linux i2c-dev interface (/dev/i2c-N).
+
+// Standard C/C++ headers
+#include <cassert>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+
+// Linux headers
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#include <unistd.h>
+
+// Local headers
+#include "linuxI2CBackend.h"
+
+int LinuxI2CBackend::Open(const std::string& deviceFileName)
+{
+	return open(deviceFileName.c_str(), O_RDWR);
+}
+
+void LinuxI2CBackend::Close(const int& handle)
+{
+	close(handle);
+}
+
+bool LinuxI2CBackend::SelectSlave(const int& handle, const unsigned char& address)
+{
+	return ioctl(handle, I2C_SLAVE, address) != -1;
+}
+
+int LinuxI2CBackend::Write(const int& handle, const unsigned char* data, const size_t& size)
+{
+	return write(handle, data, size);
+}
+
+int LinuxI2CBackend::Read(const int& handle, unsigned char* data, const size_t& size)
+{
+	return read(handle, data, size);
+}
+
+bool LinuxI2CBackend::Transfer(const int& handle, Message* messages, const size_t& count)
+{
+	assert(count <= maxTransferMessages);
+	static_assert(maxTransferMessages == I2C_RDWR_IOCTL_MAX_MSGS, "Message limit doesn't match i2c-dev");
+
+	i2c_msg kernelMessages[maxTransferMessages];
+	size_t i;
+	for (i = 0; i < count; i++)
+	{
+		kernelMessages[i].addr = messages[i].address;
+		kernelMessages[i].flags = messages[i].read ? I2C_M_RD : 0;
+		kernelMessages[i].len = messages[i].size;
+		kernelMessages[i].buf = messages[i].data;
+	}
+
+	i2c_rdwr_ioctl_data data;
+	data.msgs = kernelMessages;
+	data.nmsgs = count;
+	return ioctl(handle, I2C_RDWR, &data) == static_cast<int>(count);
+}
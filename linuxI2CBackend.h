@@ -0,0 +1,24 @@
+// File:  linuxI2CBackend.h
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Desc:  I2C backend using the Linux i2c-dev interface (/dev/i2c-N).
+
+#ifndef LINUX_I2C_BACKEND_H_
+#define LINUX_I2C_BACKEND_H_
+
+// Local headers
+#include "i2cBackend.h"
+
+class LinuxI2CBackend : public I2CBackend
+{
+public:
+	virtual int Open(const std::string& deviceFileName);
+	virtual void Close(const int& handle);
+
+	virtual bool SelectSlave(const int& handle, const unsigned char& address);
+	virtual int Write(const int& handle, const unsigned char* data, const size_t& size);
+	virtual int Read(const int& handle, unsigned char* data, const size_t& size);
+	virtual bool Transfer(const int& handle, Message* messages, const size_t& count);
+};
+
+#endif// LINUX_I2C_BACKEND_H_
@@ -0,0 +1,488 @@
+// File:  memoryMappedGPIOBackend.cpp
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  GPIO backend that accesses the Broadcom GPIO registers directly
+//        through a memory-mapped window (normally /dev/gpiomem).  Any regular
+//        file may be used in place of the device, which allows this backend
+//        to be exercised on machines that are not a Raspberry Pi.
+
+// Standard C/C++ headers
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <chrono>
+#include <thread>
+
+// *nix standard headers
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Local headers
+#include "memoryMappedGPIOBackend.h"
+
+//==========================================================================
+// Class:			MemoryMappedGPIOBackend
+// Function:		Constant definitions
+//
+// Description:		Constant definitions for MemoryMappedGPIOBackend class.
+//					See chapter 6 of the BCM2835 ARM Peripherals datasheet
+//					and chapter 5 of the BCM2711 ARM Peripherals datasheet.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const size_t MemoryMappedGPIOBackend::registerWindowSize = 4096;// [bytes]
+const unsigned int MemoryMappedGPIOBackend::functionSelectOffset = 0x00 / 4;// GPFSEL0
+const unsigned int MemoryMappedGPIOBackend::outputSetOffset = 0x1C / 4;// GPSET0
+const unsigned int MemoryMappedGPIOBackend::outputClearOffset = 0x28 / 4;// GPCLR0
+const unsigned int MemoryMappedGPIOBackend::levelOffset = 0x34 / 4;// GPLEV0
+const unsigned int MemoryMappedGPIOBackend::pullUpDownOffset = 0x94 / 4;// GPPUD
+const unsigned int MemoryMappedGPIOBackend::pullUpDownClockOffset = 0x98 / 4;// GPPUDCLK0
+const unsigned int MemoryMappedGPIOBackend::pullUpDownControlOffset = 0xE4 / 4;// GPIO_PUP_PDN_CNTRL_REG0
+
+//==========================================================================
+// Class:			MemoryMappedGPIOBackend
+// Function:		MemoryMappedGPIOBackend
+//
+// Description:		Constructor for MemoryMappedGPIOBackend class.
+//
+// Input Arguments:
+//		registerFileName	= const std::string&, device (or regular file)
+//							  to map as the GPIO register window
+//		outStream			= std::ostream&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+MemoryMappedGPIOBackend::MemoryMappedGPIOBackend(const std::string& registerFileName,
+	std::ostream& outStream) : registers(nullptr), isBCM2711(false), outStream(outStream)
+{
+	fileDescriptor = open(registerFileName.c_str(), O_RDWR | O_SYNC);
+	if (fileDescriptor == -1)
+	{
+		outStream << "Failed to open '" << registerFileName << "':  " << strerror(errno) << std::endl;
+		return;
+	}
+
+	// When standing in for the device, a regular file must be large enough
+	// to cover every register we might touch
+	struct stat fileInfo;
+	if (fstat(fileDescriptor, &fileInfo) == 0 && S_ISREG(fileInfo.st_mode) &&
+		fileInfo.st_size < static_cast<off_t>(registerWindowSize) &&
+		ftruncate(fileDescriptor, registerWindowSize) == -1)
+	{
+		outStream << "Failed to resize '" << registerFileName << "':  " << strerror(errno) << std::endl;
+		return;
+	}
+
+	void *window(mmap(nullptr, registerWindowSize, PROT_READ | PROT_WRITE,
+		MAP_SHARED, fileDescriptor, 0));
+	if (window == MAP_FAILED)
+	{
+		outStream << "Failed to map '" << registerFileName << "':  " << strerror(errno) << std::endl;
+		return;
+	}
+
+	registers = static_cast<volatile uint32_t*>(window);
+
+	// The BCM2835 returns "gpio" in ASCII from the register where the BCM2711
+	// keeps its last pull-up/down control word
+	isBCM2711 = registers[pullUpDownControlOffset + 3] != 0x6770696f;
+}
+
+//==========================================================================
+// Class:			MemoryMappedGPIOBackend
+// Function:		~MemoryMappedGPIOBackend
+//
+// Description:		Destructor for MemoryMappedGPIOBackend class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+MemoryMappedGPIOBackend::~MemoryMappedGPIOBackend()
+{
+	if (registers)
+		munmap(const_cast<uint32_t*>(registers), registerWindowSize);
+
+	if (fileDescriptor != -1)
+		close(fileDescriptor);
+}
+
+//==========================================================================
+// Class:			MemoryMappedGPIOBackend
+// Function:		SetDataDirection
+//
+// Description:		Sets the data direction for the pin by writing the
+//					appropriate function select register.
+//
+// Input Arguments:
+//		pin			= const int&
+//		direction	= const GPIO::DataDirection&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MemoryMappedGPIOBackend::SetDataDirection(const int &pin, const GPIO::DataDirection &direction)
+{
+	const int bcmPin(GetBCMPin(pin));
+	if (bcmPin < 0)
+		return;
+
+	uint32_t function;
+	if (direction == GPIO::DataDirection::Input)
+		function = 0;// 000
+	else if (direction == GPIO::DataDirection::Output)
+		function = 1;// 001
+	else if (direction == GPIO::DataDirection::PWMOutput)
+	{
+		if (bcmPin == 12 || bcmPin == 13)
+			function = 4;// 100 (ALT0 - PWM0 on GPIO12, PWM1 on GPIO13)
+		else
+			function = 2;// 010 (ALT5 - PWM0 on GPIO18, PWM1 on GPIO19)
+	}
+	else
+	{
+		assert(false);
+		return;
+	}
+
+	const unsigned int shift((bcmPin % 10) * 3);
+	volatile uint32_t& functionSelect(registers[functionSelectOffset + bcmPin / 10]);
+	functionSelect = (functionSelect & ~(7u << shift)) | (function << shift);
+}
+
+//==========================================================================
+// Class:			MemoryMappedGPIOBackend
+// Function:		SetPullUpDown
+//
+// Description:		Sets the state of the optional internal pull-up/pull-down resistors.
+//
+// Input Arguments:
+//		pin		= const int&
+//		state	= const GPIO::PullResistance&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MemoryMappedGPIOBackend::SetPullUpDown(const int &pin, const GPIO::PullResistance &state)
+{
+	const int bcmPin(GetBCMPin(pin));
+	if (bcmPin < 0)
+		return;
+
+	if (isBCM2711)
+		SetBCM2711PullUpDown(bcmPin, state);
+	else
+		SetLegacyPullUpDown(bcmPin, state);
+}
+
+//==========================================================================
+// Class:			MemoryMappedGPIOBackend
+// Function:		GetBCMPin
+//
+// Description:		Returns the Broadcom GPIO number for the pin, or -1 if the
+//					pin doesn't exist or the registers couldn't be mapped (the
+//					constructor already reported why).
+//
+// Input Arguments:
+//		pin	= const int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		int
+//
+//==========================================================================
+int MemoryMappedGPIOBackend::GetBCMPin(const int &pin) const
+{
+	if (!MappingOK())
+		return -1;
+
+	return WiringPiToBCM(pin);
+}
+
+//==========================================================================
+// Class:			MemoryMappedGPIOBackend
+// Function:		SetLegacyPullUpDown
+//
+// Description:		Sets pull-up/pull-down state using the clocked sequence
+//					required by the BCM2835/6/7.
+//
+// Input Arguments:
+//		bcmPin	= const int&, Broadcom GPIO number
+//		state	= const GPIO::PullResistance&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MemoryMappedGPIOBackend::SetLegacyPullUpDown(const int &bcmPin, const GPIO::PullResistance &state)
+{
+	uint32_t control;
+	if (state == GPIO::PullResistance::Off)
+		control = 0;
+	else if (state == GPIO::PullResistance::PullDown)
+		control = 1;
+	else if (state == GPIO::PullResistance::PullUp)
+		control = 2;
+	else
+	{
+		assert(false);
+		return;
+	}
+
+	// Datasheet requires 150 cycles of set-up and hold time; a few
+	// microseconds is plenty for any core clock
+	const std::chrono::microseconds settleTime(5);
+	volatile uint32_t& clock(registers[pullUpDownClockOffset + bcmPin / 32]);
+
+	registers[pullUpDownOffset] = control;
+	std::this_thread::sleep_for(settleTime);
+	clock = 1u << (bcmPin % 32);
+	std::this_thread::sleep_for(settleTime);
+	registers[pullUpDownOffset] = 0;
+	clock = 0;
+}
+
+//==========================================================================
+// Class:			MemoryMappedGPIOBackend
+// Function:		SetBCM2711PullUpDown
+//
+// Description:		Sets pull-up/pull-down state using the direct control
+//					registers of the BCM2711.
+//
+// Input Arguments:
+//		bcmPin	= const int&, Broadcom GPIO number
+//		state	= const GPIO::PullResistance&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MemoryMappedGPIOBackend::SetBCM2711PullUpDown(const int &bcmPin, const GPIO::PullResistance &state)
+{
+	uint32_t control;
+	if (state == GPIO::PullResistance::Off)
+		control = 0;
+	else if (state == GPIO::PullResistance::PullUp)
+		control = 1;
+	else if (state == GPIO::PullResistance::PullDown)
+		control = 2;
+	else
+	{
+		assert(false);
+		return;
+	}
+
+	const unsigned int shift((bcmPin % 16) * 2);
+	volatile uint32_t& pullControl(registers[pullUpDownControlOffset + bcmPin / 16]);
+	pullControl = (pullControl & ~(3u << shift)) | (control << shift);
+}
+
+//==========================================================================
+// Class:			MemoryMappedGPIOBackend
+// Function:		SetOutput
+//
+// Description:		Sets the state of the output pin with a single write to
+//					the set or clear register.
+//
+// Input Arguments:
+//		pin		= const int&
+//		high	= const bool&, true for high, false for low
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MemoryMappedGPIOBackend::SetOutput(const int &pin, const bool &high)
+{
+	const int bcmPin(GetBCMPin(pin));
+	if (bcmPin < 0)
+		return;
+
+	registers[(high ? outputSetOffset : outputClearOffset) + bcmPin / 32] = 1u << (bcmPin % 32);
+}
+
+//==========================================================================
+// Class:			MemoryMappedGPIOBackend
+// Function:		GetInput
+//
+// Description:		Reads the status of the input pin from the level register.
+//
+// Input Arguments:
+//		pin	= const int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for high, false otherwise
+//
+//==========================================================================
+bool MemoryMappedGPIOBackend::GetInput(const int &pin)
+{
+	const int bcmPin(GetBCMPin(pin));
+	if (bcmPin < 0)
+		return false;
+
+	return (registers[levelOffset + bcmPin / 32] & (1u << (bcmPin % 32))) != 0;
+}
+
+//==========================================================================
+// Class:			MemoryMappedGPIOBackend
+// Function:		SetOutputs
+//
+// Description:		Sets the state of several output pins.  All pins going
+//					high are changed by one write to the set register, and
+//					all pins going low by one write to the clear register.
+//
+// Input Arguments:
+//		pins	= const std::vector<int>&
+//		values	= const uint32_t&, bit i is the desired state of pins[i]
+//		mask	= const uint32_t&, only pins with the corresponding bit set
+//				  are changed
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void MemoryMappedGPIOBackend::SetOutputs(const std::vector<int> &pins,
+	const uint32_t &values, const uint32_t &mask)
+{
+	assert(pins.size() <= 32);
+	if (!MappingOK())
+		return;
+
+	// Two words cover all 54 Broadcom GPIOs
+	uint32_t setBits[2] = {0, 0};
+	uint32_t clearBits[2] = {0, 0};
+
+	unsigned int i;
+	for (i = 0; i < pins.size(); i++)
+	{
+		if ((mask & (1u << i)) == 0)
+			continue;
+
+		const int bcmPin(WiringPiToBCM(pins[i]));
+		if (bcmPin < 0)
+			continue;
+
+		if (values & (1u << i))
+			setBits[bcmPin / 32] |= 1u << (bcmPin % 32);
+		else
+			clearBits[bcmPin / 32] |= 1u << (bcmPin % 32);
+	}
+
+	for (i = 0; i < 2; i++)
+	{
+		if (setBits[i] != 0)
+			registers[outputSetOffset + i] = setBits[i];
+		if (clearBits[i] != 0)
+			registers[outputClearOffset + i] = clearBits[i];
+	}
+}
+
+//==========================================================================
+// Class:			MemoryMappedGPIOBackend
+// Function:		GetInputs
+//
+// Description:		Reads the state of several input pins from a single
+//					snapshot of the level registers.
+//
+// Input Arguments:
+//		pins	= const std::vector<int>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		uint32_t, bit i is set if pins[i] is high
+//
+//==========================================================================
+uint32_t MemoryMappedGPIOBackend::GetInputs(const std::vector<int> &pins)
+{
+	assert(pins.size() <= 32);
+	if (!MappingOK())
+		return 0;
+
+	const uint32_t levels[2] = {registers[levelOffset], registers[levelOffset + 1]};
+
+	uint32_t values(0);
+	unsigned int i;
+	for (i = 0; i < pins.size(); i++)
+	{
+		const int bcmPin(WiringPiToBCM(pins[i]));
+		if (bcmPin >= 0 && levels[bcmPin / 32] & (1u << (bcmPin % 32)))
+			values |= 1u << i;
+	}
+
+	return values;
+}
+
+//==========================================================================
+// Class:			MemoryMappedGPIOBackend
+// Function:		AttachInterrupt
+//
+// Description:		Edge detection requires kernel support, which this
+//					backend bypasses, so interrupts are not available.
+//
+// Input Arguments:
+//		interrupt	= Interrupt&
+//		edge		= const Interrupt::EdgeDirection&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, always false
+//
+//==========================================================================
+bool MemoryMappedGPIOBackend::AttachInterrupt(Interrupt &interrupt,
+	const Interrupt::EdgeDirection &/*edge*/)
+{
+	outStream << "Interrupts are not supported by the memory-mapped backend (pin "
+		<< interrupt.GetPin() << ")" << std::endl;
+	return false;
+}
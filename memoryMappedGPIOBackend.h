@@ -0,0 +1,64 @@
+// File:  memoryMappedGPIOBackend.h
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  GPIO backend that accesses the Broadcom GPIO registers directly
+//        through a memory-mapped window (normally /dev/gpiomem).  Any regular
+//        file may be used in place of the device, which allows this backend
+//        to be exercised on machines that are not a Raspberry Pi.
+
+#ifndef MEMORY_MAPPED_GPIO_BACKEND_H_
+#define MEMORY_MAPPED_GPIO_BACKEND_H_
+
+// Standard C++ headers
+#include <string>
+#include <iostream>
+#include <cstdint>
+
+// Local headers
+#include "gpioBackend.h"
+
+class MemoryMappedGPIOBackend : public GPIOBackend
+{
+public:
+	MemoryMappedGPIOBackend(const std::string& registerFileName = "/dev/gpiomem",
+		std::ostream& outStream = std::cout);
+	virtual ~MemoryMappedGPIOBackend();
+
+	virtual void SetDataDirection(const int &pin, const GPIO::DataDirection &direction);
+	virtual void SetPullUpDown(const int &pin, const GPIO::PullResistance &state);
+	virtual void SetOutput(const int &pin, const bool &high);
+	virtual bool GetInput(const int &pin);
+
+	virtual void SetOutputs(const std::vector<int> &pins, const uint32_t &values, const uint32_t &mask);
+	virtual uint32_t GetInputs(const std::vector<int> &pins);
+
+	virtual bool AttachInterrupt(Interrupt &interrupt, const Interrupt::EdgeDirection &edge);
+
+	bool MappingOK() const { return registers != nullptr; }
+
+private:
+	static const size_t registerWindowSize;// [bytes]
+
+	// Register offsets (in 32-bit words, not bytes)
+	static const unsigned int functionSelectOffset;
+	static const unsigned int outputSetOffset;
+	static const unsigned int outputClearOffset;
+	static const unsigned int levelOffset;
+	static const unsigned int pullUpDownOffset;
+	static const unsigned int pullUpDownClockOffset;
+	static const unsigned int pullUpDownControlOffset;// BCM2711 only
+
+	int fileDescriptor;
+	volatile uint32_t *registers;
+	bool isBCM2711;
+
+	std::ostream& outStream;
+
+	int GetBCMPin(const int &pin) const;
+
+	void SetLegacyPullUpDown(const int &bcmPin, const GPIO::PullResistance &state);
+	void SetBCM2711PullUpDown(const int &bcmPin, const GPIO::PullResistance &state);
+};
+
+#endif// MEMORY_MAPPED_GPIO_BACKEND_H_
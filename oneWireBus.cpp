@@ -0,0 +1,842 @@
+// File:  oneWireBus.cpp
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  User-space 1-wire bus master, bit-banged on any GPIO pin (with an
+//        external pull-up resistor, typically 4.7k).  Unlike the kernel's
+//        w1-gpio driver, any number of buses can be used, on any pins, and
+//        all DS18B20s on a bus convert at once.  Slot timing is done by
+//        busy-waiting, so use a fast GPIO backend (e.g. the memory-mapped
+//        backend) - sysfs is too slow.
+
+// Standard C/C++ headers
+#include <cstdio>
+#include <cassert>
+#include <algorithm>
+
+// Local headers
+#include "oneWireBus.h"
+#include "gpioBackend.h"
+
+//==========================================================================
+// Class:			OneWireBus
+// Function:		None
+//
+// Description:		Static and constant member initialization/definitions for
+//					OneWireBus class.  Timing is for standard speed, as
+//					recommended in Maxim application note 126.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const OneWireBus::Clock::duration OneWireBus::resetLowTime(std::chrono::microseconds(480));
+const OneWireBus::Clock::duration OneWireBus::presenceSampleTime(std::chrono::microseconds(70));
+const OneWireBus::Clock::duration OneWireBus::resetRecoveryTime(std::chrono::microseconds(410));
+const OneWireBus::Clock::duration OneWireBus::writeOneLowTime(std::chrono::microseconds(6));
+const OneWireBus::Clock::duration OneWireBus::writeZeroLowTime(std::chrono::microseconds(60));
+const OneWireBus::Clock::duration OneWireBus::slotTime(std::chrono::microseconds(70));
+const OneWireBus::Clock::duration OneWireBus::readLowTime(std::chrono::microseconds(6));
+const OneWireBus::Clock::duration OneWireBus::readSampleTime(std::chrono::microseconds(15));
+const std::chrono::milliseconds OneWireBus::conversionPollPeriod(10);
+const std::array<uint8_t, 256> OneWireBus::crcTable(OneWireBus::BuildCRCTable());
+
+//==========================================================================
+// Class:			OneWireBus
+// Function:		OneWireBus
+//
+// Description:		Constructor for OneWireBus class.
+//
+// Input Arguments:
+//		pin			= const int&
+//		backend		= GPIOBackend&
+//		outStream	= std::ostream&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+OneWireBus::OneWireBus(const int &pin, GPIOBackend &backend, std::ostream &outStream)
+	: GPIO(pin, DataDirection::Input, backend), outStream(outStream), stopContinuous(false)
+{
+	// The bus is open-drain:  the output latch is always low, and the pin is
+	// switched between output (pulling the bus low) and input (releasing it).
+	// The internal pull-up is too weak on its own, but it doesn't hurt.
+	SetPullUpDown(PullResistance::PullUp);
+	this->backend.SetOutput(pin, false);
+}
+
+//==========================================================================
+// Class:			OneWireBus
+// Function:		~OneWireBus
+//
+// Description:		Destructor for OneWireBus class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+OneWireBus::~OneWireBus()
+{
+	StopContinuous();
+}
+
+//==========================================================================
+// Class:			OneWireBus
+// Function:		Search
+//
+// Description:		Finds the ROM codes of all devices on the bus, using the
+//					search algorithm from Maxim application note 187.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		roms	= std::vector<ROM>&
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool OneWireBus::Search(std::vector<ROM> &roms)
+{
+	std::lock_guard<std::mutex> lock(busMutex);
+	roms.clear();
+
+	ROM rom(0);
+	unsigned int lastDiscrepancy(0);
+	do
+	{
+		if (!Reset())
+			return true;// No devices
+
+		WriteByte(SearchROM);
+
+		unsigned int lastZero(0);
+		unsigned int bitNumber;
+		for (bitNumber = 1; bitNumber <= 64; bitNumber++)
+		{
+			const bool idBit(ReadBit());
+			const bool complementBit(ReadBit());
+			const ROM mask(ROM(1) << (bitNumber - 1));
+
+			bool direction;
+			if (idBit && complementBit)
+			{
+				outStream << "1-wire search failed on pin " << pin << ":  no devices responded" << std::endl;
+				return false;
+			}
+			else if (idBit != complementBit)// All remaining devices agree
+				direction = idBit;
+			else
+			{
+				// Discrepancy - take the 1 branch on this pass only if we
+				// took the 0 branch here last time
+				if (bitNumber < lastDiscrepancy)
+					direction = (rom & mask) != 0;
+				else
+					direction = bitNumber == lastDiscrepancy;
+
+				if (!direction)
+					lastZero = bitNumber;
+			}
+
+			if (direction)
+				rom |= mask;
+			else
+				rom &= ~mask;
+			WriteBit(direction);
+		}
+
+		uint8_t bytes[8];
+		unsigned int i;
+		for (i = 0; i < 8; i++)
+			bytes[i] = static_cast<uint8_t>(rom >> (8 * i));
+
+		if (ComputeCRC8(bytes, sizeof(bytes)) != 0)
+		{
+			outStream << "1-wire search failed on pin " << pin << ":  bad ROM CRC" << std::endl;
+			return false;
+		}
+
+		roms.push_back(rom);
+		lastDiscrepancy = lastZero;
+	} while (lastDiscrepancy != 0);
+
+	return true;
+}
+
+//==========================================================================
+// Class:			OneWireBus
+// Function:		ConvertAll
+//
+// Description:		Starts a temperature conversion on every device on the
+//					bus and waits for it to complete.
+//
+// Input Arguments:
+//		timeout	= const std::chrono::milliseconds&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool OneWireBus::ConvertAll(const std::chrono::milliseconds &timeout)
+{
+	std::unique_lock<std::mutex> lock(busMutex);
+	if (!Reset())
+		return false;
+
+	WriteByte(SkipROM);
+	WriteByte(ConvertT);
+
+	lock.unlock();
+	return WaitForConversion(timeout);
+}
+
+//==========================================================================
+// Class:			OneWireBus
+// Function:		Convert
+//
+// Description:		Starts a temperature conversion on the specified device
+//					and waits for it to complete.
+//
+// Input Arguments:
+//		rom		= const ROM&
+//		timeout	= const std::chrono::milliseconds&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool OneWireBus::Convert(const ROM &rom, const std::chrono::milliseconds &timeout)
+{
+	std::unique_lock<std::mutex> lock(busMutex);
+	if (!Select(rom))
+		return false;
+
+	WriteByte(ConvertT);
+
+	lock.unlock();
+	return WaitForConversion(timeout);
+}
+
+//==========================================================================
+// Class:			OneWireBus
+// Function:		ReadScratchpad
+//
+// Description:		Reads the specified device's scratchpad and checks its CRC.
+//
+// Input Arguments:
+//		rom			= const ROM&
+//
+// Output Arguments:
+//		scratchpad	= Scratchpad&
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool OneWireBus::ReadScratchpad(const ROM &rom, Scratchpad &scratchpad)
+{
+	{
+		std::lock_guard<std::mutex> lock(busMutex);
+		if (!Select(rom))
+			return false;
+
+		WriteByte(ReadScratchpadCommand);
+		for (auto& byte : scratchpad)
+			byte = ReadByte();
+	}
+
+	// All ones (which would otherwise pass) means nobody answered
+	if (std::all_of(scratchpad.begin(), scratchpad.end(), [](const uint8_t& byte)
+	{
+		return byte == 0xFF;
+	}) || ComputeCRC8(scratchpad.data(), scratchpad.size()) != 0)
+	{
+		outStream << "Bad scratchpad CRC (" << ROMToString(rom) << ")" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			OneWireBus
+// Function:		ReadTemperature
+//
+// Description:		Reads the result of the last conversion from the
+//					specified DS18B20.
+//
+// Input Arguments:
+//		rom			= const ROM&
+//
+// Output Arguments:
+//		temperature	= double& [deg C]
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool OneWireBus::ReadTemperature(const ROM &rom, double &temperature)
+{
+	Scratchpad scratchpad;
+	if (!ReadScratchpad(rom, scratchpad))
+		return false;
+
+	// Sixteenths of a degree; unused low bits are undefined at lower resolutions
+	const unsigned int resolution(9 + ((scratchpad[4] >> 5) & 0x03));
+	int16_t raw(static_cast<int16_t>(scratchpad[0] | (scratchpad[1] << 8)));
+	raw &= ~((1 << (12 - resolution)) - 1);
+
+	temperature = raw / 16.0;
+	return true;
+}
+
+//==========================================================================
+// Class:			OneWireBus
+// Function:		StartContinuous
+//
+// Description:		Starts the background thread.
+//
+// Input Arguments:
+//		period	= const std::chrono::milliseconds&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false if already running
+//
+//==========================================================================
+bool OneWireBus::StartContinuous(const std::chrono::milliseconds &period)
+{
+	if (continuousThread.joinable())
+		return false;
+
+	stopContinuous = false;
+	continuousThread = std::thread(&OneWireBus::ContinuousThreadEntry, this, period);
+	return true;
+}
+
+//==========================================================================
+// Class:			OneWireBus
+// Function:		StopContinuous
+//
+// Description:		Stops the background thread.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void OneWireBus::StopContinuous()
+{
+	if (!continuousThread.joinable())
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(continuousMutex);
+		stopContinuous = true;
+	}
+
+	stopRequested.notify_all();
+	continuousThread.join();
+}
+
+//==========================================================================
+// Class:			OneWireBus
+// Function:		GetLatestReading
+//
+// Description:		Returns the most recent reading from the specified device.
+//
+// Input Arguments:
+//		rom		= const ROM&
+//
+// Output Arguments:
+//		reading	= Reading&
+//
+// Return Value:
+//		bool, true if a reading is available, false otherwise
+//
+//==========================================================================
+bool OneWireBus::GetLatestReading(const ROM &rom, Reading &reading) const
+{
+	std::lock_guard<std::mutex> lock(readingMutex);
+	const auto it(readings.find(rom));
+	if (it == readings.end())
+		return false;
+
+	reading = it->second;
+	return true;
+}
+
+//==========================================================================
+// Class:			OneWireBus
+// Function:		GetDevices
+//
+// Description:		Returns the devices found by the most recent search in
+//					continuous mode.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::vector<ROM>
+//
+//==========================================================================
+std::vector<OneWireBus::ROM> OneWireBus::GetDevices() const
+{
+	std::lock_guard<std::mutex> lock(readingMutex);
+	return devices;
+}
+
+//==========================================================================
+// Class:			OneWireBus
+// Function:		ComputeCRC8
+//
+// Description:		Computes the Dallas/Maxim 1-wire CRC.  Running the CRC
+//					over data that includes its own CRC byte gives zero.
+//
+// Input Arguments:
+//		data	= const uint8_t*
+//		size	= const size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		uint8_t
+//
+//==========================================================================
+uint8_t OneWireBus::ComputeCRC8(const uint8_t *data, const size_t &size)
+{
+	uint8_t crc(0);
+	size_t i;
+	for (i = 0; i < size; i++)
+		crc = crcTable[crc ^ data[i]];
+
+	return crc;
+}
+
+//==========================================================================
+// Class:			OneWireBus
+// Function:		ROMToString
+//
+// Description:		Formats the ROM code as family-serial, as the kernel does.
+//
+// Input Arguments:
+//		rom	= const ROM&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::string
+//
+//==========================================================================
+std::string OneWireBus::ROMToString(const ROM &rom)
+{
+	char buffer[16];
+	snprintf(buffer, sizeof(buffer), "%02x-%012llx", static_cast<unsigned int>(rom & 0xFF),
+		static_cast<unsigned long long>((rom >> 8) & 0xFFFFFFFFFFFFULL));
+	return buffer;
+}
+
+//==========================================================================
+// Class:			OneWireBus
+// Function:		BuildCRCTable
+//
+// Description:		Computes the CRC for every possible byte (polynomial
+//					x^8 + x^5 + x^4 + 1, reflected).
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::array<uint8_t, 256>
+//
+//==========================================================================
+std::array<uint8_t, 256> OneWireBus::BuildCRCTable()
+{
+	std::array<uint8_t, 256> table;
+	unsigned int i, bit;
+	for (i = 0; i < table.size(); i++)
+	{
+		uint8_t crc(static_cast<uint8_t>(i));
+		for (bit = 0; bit < 8; bit++)
+			crc = (crc & 0x01) ? (crc >> 1) ^ 0x8C : crc >> 1;
+		table[i] = crc;
+	}
+
+	return table;
+}
+
+//==========================================================================
+// Class:			OneWireBus
+// Function:		Reset
+//
+// Description:		Sends a reset pulse and checks for a presence pulse.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if any device is present, false otherwise
+//
+//==========================================================================
+bool OneWireBus::Reset()
+{
+	const Clock::time_point start(Clock::now());
+	DriveLow();
+	SpinUntil(start + resetLowTime);
+	Release();
+
+	SpinUntil(start + resetLowTime + presenceSampleTime);
+	const bool present(!backend.GetInput(pin));
+	SpinUntil(start + resetLowTime + presenceSampleTime + resetRecoveryTime);
+
+	return present;
+}
+
+//==========================================================================
+// Class:			OneWireBus
+// Function:		WriteBit
+//
+// Description:		Writes a single time slot.
+//
+// Input Arguments:
+//		bit	= const bool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void OneWireBus::WriteBit(const bool &bit)
+{
+	const Clock::time_point start(Clock::now());
+	DriveLow();
+	SpinUntil(start + (bit ? writeOneLowTime : writeZeroLowTime));
+	Release();
+	SpinUntil(start + slotTime);
+}
+
+//==========================================================================
+// Class:			OneWireBus
+// Function:		ReadBit
+//
+// Description:		Reads a single time slot.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool OneWireBus::ReadBit()
+{
+	const Clock::time_point start(Clock::now());
+	DriveLow();
+	SpinUntil(start + readLowTime);
+	Release();
+	SpinUntil(start + readSampleTime);
+	const bool bit(backend.GetInput(pin));
+	SpinUntil(start + slotTime);
+
+	return bit;
+}
+
+//==========================================================================
+// Class:			OneWireBus
+// Function:		WriteByte
+//
+// Description:		Writes a byte, least significant bit first.
+//
+// Input Arguments:
+//		byte	= const uint8_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void OneWireBus::WriteByte(const uint8_t &byte)
+{
+	unsigned int i;
+	for (i = 0; i < 8; i++)
+		WriteBit(((byte >> i) & 0x01) != 0);
+}
+
+//==========================================================================
+// Class:			OneWireBus
+// Function:		ReadByte
+//
+// Description:		Reads a byte, least significant bit first.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		uint8_t
+//
+//==========================================================================
+uint8_t OneWireBus::ReadByte()
+{
+	uint8_t byte(0);
+	unsigned int i;
+	for (i = 0; i < 8; i++)
+	{
+		if (ReadBit())
+			byte |= 1 << i;
+	}
+
+	return byte;
+}
+
+//==========================================================================
+// Class:			OneWireBus
+// Function:		Select
+//
+// Description:		Resets the bus and addresses the specified device.
+//
+// Input Arguments:
+//		rom	= const ROM&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if any device is present, false otherwise
+//
+//==========================================================================
+bool OneWireBus::Select(const ROM &rom)
+{
+	if (!Reset())
+		return false;
+
+	WriteByte(MatchROM);
+	unsigned int i;
+	for (i = 0; i < 8; i++)
+		WriteByte(static_cast<uint8_t>(rom >> (8 * i)));
+
+	return true;
+}
+
+//==========================================================================
+// Class:			OneWireBus
+// Function:		WaitForConversion
+//
+// Description:		Issues read slots until the converting devices release
+//					the bus.  The bus is unlocked between polls, so other
+//					threads can use it (e.g. to read other devices) meanwhile.
+//
+// Input Arguments:
+//		timeout	= const std::chrono::milliseconds&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool OneWireBus::WaitForConversion(const std::chrono::milliseconds &timeout)
+{
+	const Clock::time_point deadline(Clock::now() + timeout);
+	while (true)
+	{
+		std::this_thread::sleep_for(conversionPollPeriod);
+
+		{
+			std::lock_guard<std::mutex> lock(busMutex);
+			if (ReadBit())
+				return true;
+		}
+
+		if (Clock::now() > deadline)
+		{
+			outStream << "Timed out waiting for 1-wire conversion on pin " << pin << std::endl;
+			return false;
+		}
+	}
+}
+
+//==========================================================================
+// Class:			OneWireBus
+// Function:		DriveLow
+//
+// Description:		Pulls the bus low.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void OneWireBus::DriveLow()
+{
+	backend.SetDataDirection(pin, DataDirection::Output);
+}
+
+//==========================================================================
+// Class:			OneWireBus
+// Function:		Release
+//
+// Description:		Lets the pull-up resistor pull the bus high.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void OneWireBus::Release()
+{
+	backend.SetDataDirection(pin, DataDirection::Input);
+}
+
+//==========================================================================
+// Class:			OneWireBus
+// Function:		SpinUntil
+//
+// Description:		Busy-waits until the specified time.  Sleeping isn't
+//					accurate enough for 1-wire slots.
+//
+// Input Arguments:
+//		time	= const Clock::time_point&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void OneWireBus::SpinUntil(const Clock::time_point &time)
+{
+	while (Clock::now() < time)
+	{
+	}
+}
+
+//==========================================================================
+// Class:			OneWireBus
+// Function:		ContinuousThreadEntry
+//
+// Description:		Entry point for the continuous mode thread.
+//
+// Input Arguments:
+//		period	= const std::chrono::milliseconds
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void OneWireBus::ContinuousThreadEntry(const std::chrono::milliseconds period)
+{
+	Clock::time_point nextTime(Clock::now());
+	while (true)
+	{
+		// Search every time so that added and removed sensors are noticed
+		std::vector<ROM> roms;
+		if (Search(roms))
+		{
+			roms.erase(std::remove_if(roms.begin(), roms.end(), [](const ROM& rom)
+			{
+				return (rom & 0xFF) != ds18b20FamilyCode;
+			}), roms.end());
+
+			std::lock_guard<std::mutex> lock(readingMutex);
+			devices = roms;
+			for (auto it = readings.begin(); it != readings.end();)
+			{
+				if (std::find(roms.begin(), roms.end(), it->first) == roms.end())
+					it = readings.erase(it);
+				else
+					++it;
+			}
+		}
+		else
+			roms = GetDevices();
+
+		const bool converted(!roms.empty() && ConvertAll());
+		for (const auto& rom : roms)
+		{
+			double temperature(0.0);
+			const bool valid(converted && ReadTemperature(rom, temperature));
+
+			std::lock_guard<std::mutex> lock(readingMutex);
+			Reading& reading(readings[rom]);
+			reading.valid = valid;
+			if (valid)
+				reading.temperature = temperature;
+			reading.time = Clock::now();
+		}
+
+		nextTime = std::max(nextTime + period, Clock::now());
+		std::unique_lock<std::mutex> lock(continuousMutex);
+		if (stopRequested.wait_until(lock, nextTime, [this]()
+		{
+			return stopContinuous;
+		}))
+			return;
+	}
+}
@@ -0,0 +1,128 @@
+// File:  oneWireBus.h
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  User-space 1-wire bus master, bit-banged on any GPIO pin (with an
+//        external pull-up resistor, typically 4.7k).  Unlike the kernel's
+//        w1-gpio driver, any number of buses can be used, on any pins, and
+//        all DS18B20s on a bus convert at once.  Slot timing is done by
+//        busy-waiting, so use a fast GPIO backend (e.g. the memory-mapped
+//        backend) - sysfs is too slow.
+
+#ifndef ONE_WIRE_BUS_H_
+#define ONE_WIRE_BUS_H_
+
+// Standard C++ headers
+#include <array>
+#include <vector>
+#include <map>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <iostream>
+#include <cstdint>
+
+// Local headers
+#include "gpio.h"
+
+class OneWireBus : public GPIO
+{
+public:
+	OneWireBus(const int &pin, GPIOBackend &backend = GetDefaultBackend(),
+		std::ostream &outStream = std::cout);
+	~OneWireBus();
+
+	// Family code in the least significant byte, CRC in the most significant
+	// byte (i.e. the order in which the bytes appear on the bus)
+	typedef uint64_t ROM;
+
+	static const uint8_t ds18b20FamilyCode = 0x28;
+
+	// Finds every device on the bus.  Returns false on a bus error (an empty
+	// list with a true return means there are no devices).
+	bool Search(std::vector<ROM> &roms);
+
+	// Skip ROM + Convert T:  starts a conversion on every device on the bus
+	// and waits for all of them to finish (requires externally powered sensors)
+	bool ConvertAll(const std::chrono::milliseconds &timeout = std::chrono::milliseconds(750));
+
+	// Match ROM + Convert T for a single device
+	bool Convert(const ROM &rom, const std::chrono::milliseconds &timeout = std::chrono::milliseconds(750));
+
+	typedef std::array<uint8_t, 9> Scratchpad;
+	bool ReadScratchpad(const ROM &rom, Scratchpad &scratchpad);// Fails if the CRC doesn't match
+	bool ReadTemperature(const ROM &rom, double &temperature);// [deg C], from the last conversion
+
+	// Continuous mode:  a background thread searches the bus, converts and
+	// reads every DS18B20 once per period.  Each bus has its own thread, so
+	// several buses run in parallel.
+	bool StartContinuous(const std::chrono::milliseconds &period);
+	void StopContinuous();
+	bool IsContinuous() const { return continuousThread.joinable(); }
+
+	typedef std::chrono::steady_clock Clock;
+
+	struct Reading
+	{
+		bool valid;// False if the most recent read failed
+		double temperature;// [deg C], from the most recent successful read
+		Clock::time_point time;// Of the most recent read
+	};
+
+	// Continuous mode only.  Returns false if the device hasn't been found.
+	bool GetLatestReading(const ROM &rom, Reading &reading) const;
+	std::vector<ROM> GetDevices() const;// Found by the most recent search
+
+	static uint8_t ComputeCRC8(const uint8_t *data, const size_t &size);
+
+	// Formats the ROM the same way as the kernel (e.g. "28-000005e2fdc3")
+	static std::string ROMToString(const ROM &rom);
+
+private:
+	static const Clock::duration resetLowTime, presenceSampleTime, resetRecoveryTime;
+	static const Clock::duration writeOneLowTime, writeZeroLowTime, slotTime;
+	static const Clock::duration readLowTime, readSampleTime;
+	static const std::chrono::milliseconds conversionPollPeriod;
+	static const std::array<uint8_t, 256> crcTable;
+	static std::array<uint8_t, 256> BuildCRCTable();
+
+	enum Command : uint8_t
+	{
+		SearchROM = 0xF0,
+		MatchROM = 0x55,
+		SkipROM = 0xCC,
+		ConvertT = 0x44,
+		ReadScratchpadCommand = 0xBE
+	};
+
+	std::ostream &outStream;
+	std::mutex busMutex;// Held for each complete transaction
+
+	// Bus primitives - call with busMutex locked
+	bool Reset();// Returns true if a presence pulse was detected
+	void WriteBit(const bool &bit);
+	bool ReadBit();
+	void WriteByte(const uint8_t &byte);
+	uint8_t ReadByte();
+	bool Select(const ROM &rom);
+	void DriveLow();
+	void Release();
+	static void SpinUntil(const Clock::time_point &time);
+
+	// Call with busMutex unlocked
+	bool WaitForConversion(const std::chrono::milliseconds &timeout);
+
+	std::thread continuousThread;
+	std::mutex continuousMutex;
+	std::condition_variable stopRequested;
+	bool stopContinuous;
+	void ContinuousThreadEntry(const std::chrono::milliseconds period);
+
+	mutable std::mutex readingMutex;
+	std::vector<ROM> devices;
+	std::map<ROM, Reading> readings;
+};
+
+#endif// ONE_WIRE_BUS_H_
@@ -0,0 +1,65 @@
+// File:  oneWireDS18B20.cpp
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  Temperature sensor object for a DS18B20 on a user-space OneWireBus
+//        (as opposed to the DS18B20 class, which uses the kernel driver).
+
+// Standard C++ headers
+#include <cassert>
+
+// Local headers
+#include "oneWireDS18B20.h"
+
+//==========================================================================
+// Class:			OneWireDS18B20
+// Function:		OneWireDS18B20
+//
+// Description:		Constructor for OneWireDS18B20 class.
+//
+// Input Arguments:
+//		bus	= OneWireBus&
+//		rom	= const OneWireBus::ROM&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+OneWireDS18B20::OneWireDS18B20(OneWireBus &bus, const OneWireBus::ROM &rom) : bus(bus), rom(rom)
+{
+	assert((rom & 0xFF) == OneWireBus::ds18b20FamilyCode);
+}
+
+//==========================================================================
+// Class:			OneWireDS18B20
+// Function:		GetTemperature
+//
+// Description:		Returns the sensor's temperature.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		temperature	= double& [deg C]
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool OneWireDS18B20::GetTemperature(double &temperature) const
+{
+	if (bus.IsContinuous())
+	{
+		OneWireBus::Reading reading;
+		if (!bus.GetLatestReading(rom, reading) || !reading.valid)
+			return false;
+
+		temperature = reading.temperature;
+		return true;
+	}
+
+	return bus.Convert(rom) && bus.ReadTemperature(rom, temperature);
+}
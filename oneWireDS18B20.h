@@ -0,0 +1,31 @@
+// File:  oneWireDS18B20.h
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  Temperature sensor object for a DS18B20 on a user-space OneWireBus
+//        (as opposed to the DS18B20 class, which uses the kernel driver).
+
+#ifndef ONE_WIRE_DS18B20_H_
+#define ONE_WIRE_DS18B20_H_
+
+// Local headers
+#include "temperatureSensor.h"
+#include "oneWireBus.h"
+
+class OneWireDS18B20 : public TemperatureSensor
+{
+public:
+	OneWireDS18B20(OneWireBus &bus, const OneWireBus::ROM &rom);
+
+	// If the bus is in continuous mode, returns its latest reading for this
+	// sensor; otherwise converts and reads this sensor (blocks for up to 750 ms)
+	virtual bool GetTemperature(double &temperature) const;// [deg C]
+
+	OneWireBus::ROM GetROM() const { return rom; }
+
+private:
+	OneWireBus &bus;
+	const OneWireBus::ROM rom;
+};
+
+#endif// ONE_WIRE_DS18B20_H_
@@ -0,0 +1,160 @@
+// File:  pingScheduler.cpp
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  Owns a group of ping sensors and fires them continuously from a
+//        background thread in a configurable pattern.  Sensors that can't
+//        hear each other may be fired together to increase the overall
+//        update rate; sensors that can are fired in separate groups, with a
+//        guard time in between to avoid crosstalk.
+
+// Local headers
+#include "pingScheduler.h"
+
+// Standard C++ headers
+#include <cassert>
+
+PingScheduler::PingScheduler() : guardTime(std::chrono::milliseconds(10)), stopThread(false), cycleDuration(0)
+{
+}
+
+PingScheduler::~PingScheduler()
+{
+	Stop();
+}
+
+unsigned int PingScheduler::AddSensor(const unsigned int& triggerPin, const unsigned int& echoPin,
+	const PingSensor::TimingMode& mode)
+{
+	assert(!thread.joinable());
+
+	sensors.push_back(std::unique_ptr<PingSensor>(new PingSensor(triggerPin, echoPin, mode)));
+	readings.resize(sensors.size());
+
+	const unsigned int index(sensors.size() - 1);
+	groups.push_back(std::vector<unsigned int>(1, index));
+	return index;
+}
+
+bool PingScheduler::SetFiringGroups(const std::vector<std::vector<unsigned int>>& groups)
+{
+	assert(!thread.joinable());
+
+	for (const auto& group : groups)
+	{
+		for (const auto& sensor : group)
+		{
+			if (sensor >= sensors.size())
+				return false;
+		}
+	}
+
+	this->groups = groups;
+	return true;
+}
+
+void PingScheduler::SetGuardTime(const std::chrono::microseconds& guardTime)
+{
+	assert(!thread.joinable());
+	this->guardTime = guardTime;
+}
+
+bool PingScheduler::Start()
+{
+	if (thread.joinable() || groups.empty())
+		return false;
+
+	stopThread = false;
+	thread = std::thread(&PingScheduler::ThreadEntry, this);
+	return true;
+}
+
+void PingScheduler::Stop()
+{
+	if (!thread.joinable())
+		return;
+
+	stopThread = true;
+	thread.join();
+}
+
+PingScheduler::Reading PingScheduler::GetReading(const unsigned int& sensor) const
+{
+	std::lock_guard<std::mutex> lock(readingMutex);
+	assert(sensor < readings.size());
+	return readings[sensor];
+}
+
+std::vector<PingScheduler::Reading> PingScheduler::GetReadings() const
+{
+	std::lock_guard<std::mutex> lock(readingMutex);
+	return readings;
+}
+
+double PingScheduler::GetAggregateUpdateRate() const
+{
+	const Clock::duration duration(cycleDuration.load());
+	if (duration == Clock::duration::zero())
+		return 0.0;
+
+	size_t measurementCount(0);
+	for (const auto& group : groups)
+		measurementCount += group.size();
+
+	return measurementCount / std::chrono::duration<double>(duration).count();
+}
+
+void PingScheduler::ThreadEntry()
+{
+	while (!stopThread)
+	{
+		const Clock::time_point cycleStart(Clock::now());
+		for (const auto& group : groups)
+		{
+			if (stopThread)
+				return;
+
+			FireGroup(group);
+			std::this_thread::sleep_for(guardTime);
+		}
+
+		cycleDuration = (Clock::now() - cycleStart).count();
+	}
+}
+
+void PingScheduler::FireGroup(const std::vector<unsigned int>& group)
+{
+	for (const auto& sensor : group)
+	{
+		if (sensors[sensor]->IsInterruptDriven())
+			sensors[sensor]->StartMeasurement();
+	}
+
+	// Edges are queued with their timestamps, so waiting on the sensors one
+	// after another with a common deadline doesn't affect the results
+	const Interrupt::Clock::time_point deadline(Interrupt::Clock::now() + PingSensor::timeout);
+
+	double distance;
+	for (const auto& sensor : group)
+	{
+		if (!sensors[sensor]->IsInterruptDriven())
+			Publish(sensor, sensors[sensor]->GetDistance(distance), distance);
+	}
+
+	for (const auto& sensor : group)
+	{
+		if (sensors[sensor]->IsInterruptDriven())
+			Publish(sensor, sensors[sensor]->FinishMeasurement(distance, deadline), distance);
+	}
+}
+
+void PingScheduler::Publish(const unsigned int& sensor, const bool& valid, const double& distance)
+{
+	std::lock_guard<std::mutex> lock(readingMutex);
+	Reading& reading(readings[sensor]);
+	reading.valid = valid;
+	if (valid)
+		reading.distance = distance;
+	reading.time = Clock::now();
+	reading.sequence++;
+}
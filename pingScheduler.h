@@ -0,0 +1,82 @@
+// File:  pingScheduler.h
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  Owns a group of ping sensors and fires them continuously from a
+//        background thread in a configurable pattern.  Sensors that can't
+//        hear each other may be fired together to increase the overall
+//        update rate; sensors that can are fired in separate groups, with a
+//        guard time in between to avoid crosstalk.
+
+#ifndef PING_SCHEDULER_H_
+#define PING_SCHEDULER_H_
+
+// Local headers
+#include "rpi/pingSensor.h"
+
+// Standard C++ headers
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+class PingScheduler
+{
+public:
+	PingScheduler();
+	~PingScheduler();
+
+	// Returns the index of the new sensor.  Sensors should be interrupt-driven
+	// to be fired together; polling sensors within a group are measured one
+	// at a time.
+	unsigned int AddSensor(const unsigned int& triggerPin, const unsigned int& echoPin,
+		const PingSensor::TimingMode& mode = PingSensor::TimingMode::EdgeTimestamps);
+
+	// Each group is a list of sensor indices that are fired together.  Groups
+	// are fired in order, then the pattern repeats.  By default every sensor
+	// is in its own group (fully staggered).
+	bool SetFiringGroups(const std::vector<std::vector<unsigned int>>& groups);
+
+	// Wait after each group, to let stray echoes die out
+	void SetGuardTime(const std::chrono::microseconds& guardTime);
+
+	bool Start();
+	void Stop();
+
+	typedef std::chrono::steady_clock Clock;
+
+	struct Reading
+	{
+		bool valid = false;// False if the most recent measurement failed
+		double distance = 0.0;// [cm], from the most recent successful measurement
+		Clock::time_point time;
+		uint64_t sequence = 0;// Number of measurements attempted
+	};
+
+	Reading GetReading(const unsigned int& sensor) const;
+	std::vector<Reading> GetReadings() const;
+
+	// Based on the most recent pass through all groups
+	double GetAggregateUpdateRate() const;// [Hz]
+
+private:
+	std::vector<std::unique_ptr<PingSensor>> sensors;
+	std::vector<std::vector<unsigned int>> groups;
+	std::chrono::microseconds guardTime;
+
+	mutable std::mutex readingMutex;
+	std::vector<Reading> readings;
+
+	std::thread thread;
+	std::atomic<bool> stopThread;
+	std::atomic<Clock::rep> cycleDuration;
+
+	void ThreadEntry();
+	void FireGroup(const std::vector<unsigned int>& group);
+	void Publish(const unsigned int& sensor, const bool& valid, const double& distance);
+};
+
+#endif// PING_SCHEDULER_H_
@@ -7,27 +7,80 @@
 // Local headers
 #include "pingSensor.h"
 
-// WiringPi headers
-#include <wiringPi.h>
-
 // Standard C++ headers
 #include <thread>
 #include <cassert>
 
-PingSensor::PingSensor(const unsigned int& triggerPin, const unsigned int& echoPin)
-	: trigger(triggerPin, GPIO::DataDirection::Output), echo(echoPin, GPIO::DataDirection::Input)
+const std::chrono::milliseconds PingSensor::timeout(100);
+
+PingSensor::PingSensor(const unsigned int& triggerPin, const unsigned int& echoPin,
+	const TimingMode& mode) : trigger(triggerPin, GPIO::DataDirection::Output), echoInterrupt(nullptr),
+	stopContinuous(false), readingSequence(0), latestValid(false), latestDistance(0.0), latestTime(0)
 {
 	trigger.SetOutput(false);
-	echo.SetPullUpDown(GPIO::PullResistance::Off);
+
+	if (mode == TimingMode::EdgeTimestamps)
+	{
+		const size_t queueSize(8);
+		std::unique_ptr<Interrupt> interrupt(new Interrupt(echoPin, queueSize, Interrupt::EdgeDirection::Both));
+		if (interrupt->IsAttached())
+		{
+			echoInterrupt = interrupt.get();
+			echo = std::move(interrupt);
+		}
+	}
+
+	if (!echo)
+		echo.reset(new GPIO(echoPin, GPIO::DataDirection::Input));
+	echo->SetPullUpDown(GPIO::PullResistance::Off);
+}
+
+PingSensor::~PingSensor()
+{
+	StopContinuous();
 }
 
 bool PingSensor::GetDistance(double& distance)
 {
+	if (echoInterrupt)
+	{
+		StartMeasurement();
+		return FinishMeasurement(distance, Interrupt::Clock::now() + timeout);
+	}
+
 	SendTrigger();
 	Clock::duration duration;
 	if (!MeasureEchoPulse(duration))
 		return false;
 
+	return ComputeDistance(duration, distance);
+}
+
+void PingSensor::StartMeasurement()
+{
+	assert(echoInterrupt);
+
+	// Discard edges left over from previous (e.g. timed out) measurements
+	Interrupt::EdgeEvent event;
+	while (echoInterrupt->GetEvents(&event, 1) == 1)
+		;
+
+	SendTrigger();
+}
+
+bool PingSensor::FinishMeasurement(double& distance, const Interrupt::Clock::time_point& deadline)
+{
+	assert(echoInterrupt);
+
+	Clock::duration duration;
+	if (!MeasureEchoEdges(duration, deadline))
+		return false;
+
+	return ComputeDistance(duration, distance);
+}
+
+bool PingSensor::ComputeDistance(const Clock::duration& duration, double& distance)
+{
 	const long long speedOfSound(34300);// [cm/sec]
 	const auto maxDuration(std::chrono::nanoseconds(1000000000LL * 500LL / speedOfSound));
 	if (duration > maxDuration * 1.05)// Allow some fudge room
@@ -40,23 +93,22 @@ bool PingSensor::GetDistance(double& distance)
 void PingSensor::SendTrigger()
 {
 	trigger.SetOutput(true);
-	delayMicroseconds(10);
+	std::this_thread::sleep_for(std::chrono::microseconds(10));
 	trigger.SetOutput(false);
 }
 
 bool PingSensor::MeasureEchoPulse(Clock::duration& duration)
 {
-	const unsigned int timeoutDuration(100);// [ms]
-	const auto maxTime(Clock::now() + std::chrono::milliseconds(timeoutDuration));
+	const auto maxTime(Clock::now() + timeout);
 	Clock::time_point startTime(Clock::now());
 	Clock::time_point stopTime(Clock::now());
 	
 	// Wait for rising edge
-	while (!echo.GetInput() && startTime < maxTime)
+	while (!echo->GetInput() && startTime < maxTime)
 		startTime = Clock::now();
 		
 	// Wait for falling edge
-	while (echo.GetInput() && stopTime < maxTime)
+	while (echo->GetInput() && stopTime < maxTime)
 		stopTime = Clock::now();
 		
 	if (stopTime < startTime || startTime >= maxTime || stopTime >= maxTime)
@@ -65,3 +117,99 @@ bool PingSensor::MeasureEchoPulse(Clock::duration& duration)
 	duration = stopTime - startTime;
 	return true;
 }
+
+bool PingSensor::MeasureEchoEdges(Clock::duration& duration, const Interrupt::Clock::time_point& deadline)
+{
+	bool haveRisingEdge(false);
+	Interrupt::Clock::time_point startTime;
+
+	while (echoInterrupt->WaitForEvents(deadline))
+	{
+		Interrupt::EdgeEvent event;
+		while (echoInterrupt->GetEvents(&event, 1) == 1)
+		{
+			if (event.level)
+			{
+				startTime = event.time;
+				haveRisingEdge = true;
+			}
+			else if (haveRisingEdge)
+			{
+				duration = std::chrono::duration_cast<Clock::duration>(event.time - startTime);
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+bool PingSensor::StartContinuous(const std::chrono::microseconds& period)
+{
+	if (continuousThread.joinable())
+		return false;
+
+	stopContinuous = false;
+	continuousThread = std::thread(&PingSensor::ContinuousThreadEntry, this, period);
+	return true;
+}
+
+void PingSensor::StopContinuous()
+{
+	if (!continuousThread.joinable())
+		return;
+
+	stopContinuous = true;
+	continuousThread.join();
+}
+
+void PingSensor::ContinuousThreadEntry(const std::chrono::microseconds period)
+{
+	auto nextTime(std::chrono::steady_clock::now());
+	while (!stopContinuous)
+	{
+		double distance;
+		const bool valid(GetDistance(distance));
+		StoreReading(valid, distance);
+
+		// If a measurement overruns the period, start the next one right away
+		// rather than trying to catch up
+		nextTime += period;
+		const auto now(std::chrono::steady_clock::now());
+		if (nextTime < now)
+			nextTime = now;
+		else
+			std::this_thread::sleep_until(nextTime);
+	}
+}
+
+void PingSensor::StoreReading(const bool& valid, const double& distance)
+{
+	const unsigned int sequence(readingSequence.load(std::memory_order_relaxed));
+	readingSequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	latestValid.store(valid, std::memory_order_relaxed);
+	if (valid)
+		latestDistance.store(distance, std::memory_order_relaxed);
+	latestTime.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+
+	readingSequence.store(sequence + 2, std::memory_order_release);
+}
+
+PingSensor::Reading PingSensor::GetLatestReading() const
+{
+	Reading reading;
+	unsigned int sequence;
+	do
+	{
+		sequence = readingSequence.load(std::memory_order_acquire);
+		reading.valid = latestValid.load(std::memory_order_relaxed);
+		reading.distance = latestDistance.load(std::memory_order_relaxed);
+		reading.time = std::chrono::steady_clock::time_point(
+			std::chrono::steady_clock::duration(latestTime.load(std::memory_order_relaxed)));
+		std::atomic_thread_fence(std::memory_order_acquire);
+	} while ((sequence & 1) != 0 || sequence != readingSequence.load(std::memory_order_relaxed));
+
+	return reading;
+}
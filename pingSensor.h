@@ -9,25 +9,77 @@
 
 // Local heades
 #include "rpi/gpio.h"
+#include "rpi/interrupt.h"
 
 // Standard C++ headers
 #include <chrono>
+#include <memory>
+#include <thread>
+#include <atomic>
 
 class PingSensor
 {
 public:
-	PingSensor(const unsigned int& triggerPin, const unsigned int& echoPin);
+	enum class TimingMode
+	{
+		Polling,// Spins on the echo pin
+		EdgeTimestamps// Sleeps until the echo pin's interrupt reports both edges
+	};
+
+	PingSensor(const unsigned int& triggerPin, const unsigned int& echoPin,
+		const TimingMode& mode = TimingMode::Polling);
+	~PingSensor();
 	
 	bool GetDistance(double& distance);// [cm]
 
+	static const std::chrono::milliseconds timeout;// Longest wait for an echo
+
+	// False if EdgeTimestamps was requested but the interrupt could not be attached
+	bool IsInterruptDriven() const { return echoInterrupt != nullptr; }
+
+	// Interrupt-driven sensors only:  GetDistance split in two, so that several
+	// sensors can be measured at once.  FinishMeasurement returns false if
+	// both edges have not arrived by the deadline.
+	void StartMeasurement();
+	bool FinishMeasurement(double& distance, const Interrupt::Clock::time_point& deadline);
+
+	// Continuous mode:  a background thread measures at a fixed period and
+	// stores each result, which can then be read without waiting.  Don't call
+	// GetDistance or the split measurement methods while it is running.
+	bool StartContinuous(const std::chrono::microseconds& period);
+	void StopContinuous();
+
+	struct Reading
+	{
+		bool valid;// False if the most recent measurement failed (or none has been made)
+		double distance;// [cm], from the most recent successful measurement
+		std::chrono::steady_clock::time_point time;// Of the most recent measurement
+	};
+
+	Reading GetLatestReading() const;
+
 private:
 	GPIO trigger;
-	GPIO echo;
+	std::unique_ptr<GPIO> echo;
+	Interrupt* echoInterrupt;
 	
 	void SendTrigger();
 	
 	typedef std::chrono::high_resolution_clock Clock;
 	bool MeasureEchoPulse(Clock::duration& duration);
+	bool MeasureEchoEdges(Clock::duration& duration, const Interrupt::Clock::time_point& deadline);
+	static bool ComputeDistance(const Clock::duration& duration, double& distance);
+
+	std::thread continuousThread;
+	std::atomic<bool> stopContinuous;
+	void ContinuousThreadEntry(const std::chrono::microseconds period);
+	void StoreReading(const bool& valid, const double& distance);
+
+	// Latest reading, protected by a sequence lock (odd while being written)
+	std::atomic<unsigned int> readingSequence;
+	std::atomic<bool> latestValid;
+	std::atomic<double> latestDistance;
+	std::atomic<std::chrono::steady_clock::rep> latestTime;
 };
 
 #endif// PING_SENSOR_H_
@@ -0,0 +1,25 @@
+// File:  pwmBackend.h
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  Interface for objects that drive the PWM peripheral on behalf of the
+//        PWMOutput class.
+
+#ifndef PWM_BACKEND_H_
+#define PWM_BACKEND_H_
+
+// Local headers
+#include "pwmOutput.h"
+
+class PWMBackend
+{
+public:
+	virtual ~PWMBackend() {}
+
+	virtual void SetMode(const PWMOutput::PWMMode &mode) = 0;
+	virtual void SetRange(const unsigned int &range) = 0;
+	virtual void SetClockDivisor(const unsigned int &divisor) = 0;
+	virtual void Write(const int &pin, const unsigned int &value) = 0;
+};
+
+#endif// PWM_BACKEND_H_
@@ -7,12 +7,12 @@
 // Standard C++ headers
 #include <cassert>
 #include <cmath>
-
-// Wiring pi headers
-#include <wiringPi.h>
+#include <algorithm>
+#include <limits>
 
 // Local headers
 #include "pwmOutput.h"
+#include "wiringPiPWMBackend.h"
 
 //==========================================================================
 // Class:			PWMOutput
@@ -34,6 +34,9 @@ const double PWMOutput::pwmClockFrequency = 19.2e6;// [Hz]
 const unsigned int PWMOutput::minClockDivisor = 2;
 const unsigned int PWMOutput::maxClockDivisor = 4095;
 const unsigned int PWMOutput::maxRange = 4096;
+PWMBackend *PWMOutput::defaultPWMBackend = nullptr;
+std::vector<PWMOutput*> PWMOutput::outputs;
+std::mutex PWMOutput::outputsMutex;
 
 //==========================================================================
 // Class:			PWMOutput
@@ -44,6 +47,8 @@ const unsigned int PWMOutput::maxRange = 4096;
 // Input Arguments:
 //		pin		= int, represents hardware pin number according to Wiring Pi
 //		newMode	= PWMMode, indicating the style of PWM phasing to use
+//		pwmBackend	= PWMBackend&, object that drives the PWM peripheral
+//		gpioBackend	= GPIOBackend&, object that performs the pin access
 //
 // Output Arguments:
 //		None
@@ -52,18 +57,47 @@ const unsigned int PWMOutput::maxRange = 4096;
 //		None
 //
 //==========================================================================
-PWMOutput::PWMOutput(int pin, PWMMode newMode) : GPIO(pin, DataDirection::Output)
+PWMOutput::PWMOutput(int pin, PWMMode newMode, PWMBackend &pwmBackend,
+	GPIOBackend &gpioBackend) : GPIO(pin, DataDirection::PWMOutput, gpioBackend),
+	divisor(0), pwmBackend(pwmBackend)
 {
 	SetDutyCycle(0.0);
 	SetMode(newMode);
 
 	range = 1024;
+
+	{
+		std::lock_guard<std::mutex> lock(outputsMutex);
+		outputs.push_back(this);
+	}
 	
 	// Set the frequency using the member method just in case something
 	// outside of the class manipulated it before-hand.
 	SetFrequency(pwmClockFrequency / range / minClockDivisor);
 }
 
+//==========================================================================
+// Class:			PWMOutput
+// Function:		~PWMOutput
+//
+// Description:		Destructor for PWMOutput class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+PWMOutput::~PWMOutput()
+{
+	std::lock_guard<std::mutex> lock(outputsMutex);
+	outputs.erase(std::remove(outputs.begin(), outputs.end(), this), outputs.end());
+}
+
 //==========================================================================
 // Class:			PWMOutput
 // Function:		SetDutyCycle
@@ -85,7 +119,8 @@ void PWMOutput::SetDutyCycle(double newDuty)
 	assert(newDuty >= 0.0 && newDuty <= 1.0);
 
 	duty = newDuty;
-	pwmWrite(pin, duty * range);
+	writtenValue = duty * range;
+	pwmBackend.Write(pin, writtenValue);
 }
 
 //==========================================================================
@@ -107,12 +142,15 @@ void PWMOutput::SetDutyCycle(double newDuty)
 //==========================================================================
 void PWMOutput::SetMode(PWMMode newMode)
 {
-	if (newMode == PWMMode::Balanced)
-		pwmSetMode(PWM_MODE_BAL);
-	else if (newMode == PWMMode::MarkSpace)
-		pwmSetMode(PWM_MODE_MS);
-	else
-		assert(false);
+	pwmBackend.SetMode(newMode);
+
+	// The mode is shared by the hardware channels, too
+	std::lock_guard<std::mutex> lock(outputsMutex);
+	for (auto& output : outputs)
+	{
+		if (&output->pwmBackend == &pwmBackend)
+			output->mode = newMode;
+	}
 
 	mode = newMode;
 }
@@ -137,9 +175,10 @@ void PWMOutput::SetRange(unsigned int newRange)
 {
 	assert(newRange <= maxRange);
 
-	pwmSetRange(newRange);
-	range = newRange;
-	SetDutyCycle(duty);
+	pwmBackend.SetRange(newRange);
+	const double keepDuty(duty);
+	UpdateSharedSettings(pwmBackend, divisor, newRange);
+	SetDutyCycle(keepDuty);
 }
 
 //==========================================================================
@@ -153,11 +192,8 @@ void PWMOutput::SetRange(unsigned int newRange)
 //					If the frequency cannot be achieved with the current
 //					range, this function returns false.
 //
-//					This method seems to work pretty well, but I have no proof
-//					suggesting that it will always generate the best pair or
-//					range-clock divisor values.  That criteria is somewhat
-//					dependent on your valuationg of resolution vs. frequency
-//					accuracy anyway.
+//					The range-clock divisor pair giving the frequency closest
+//					to the one requested is chosen (see FindDivisorAndRange).
 //
 // Input Arguments:
 //		newFrequency	= double [Hz]
@@ -173,34 +209,56 @@ void PWMOutput::SetRange(unsigned int newRange)
 //==========================================================================
 bool PWMOutput::SetFrequency(double newFrequency, unsigned int minResolution)
 {
-	unsigned int newRange, divisor;
+	unsigned int newRange, newDivisor;
+	if (!ComputeDivisorAndRange(newFrequency, minResolution, newDivisor, newRange))
+		return false;
+
+	pwmBackend.SetClockDivisor(newDivisor);
+	divisor = newDivisor;
+	SetRange(newRange);
+
+	frequency = pwmClockFrequency / (double)divisor / (double)newRange;
+
+	return true;
+}
+
+//==========================================================================
+// Class:			PWMOutput
+// Function:		ComputeDivisorAndRange
+//
+// Description:		Determines the clock divisor and range for the specified
+//					frequency, without changing anything.
+//
+// Input Arguments:
+//		newFrequency	= const double& [Hz]
+//		minResolution	= const unsigned int&
+//
+// Output Arguments:
+//		newDivisor		= unsigned int&
+//		newRange		= unsigned int&
+//
+// Return Value:
+//		bool, true if the frequency can be achieved, false otherwise (frequency
+//		or resolution out of bounds or wrong PWM mode)
+//
+//==========================================================================
+bool PWMOutput::ComputeDivisorAndRange(const double &newFrequency, const unsigned int &minResolution,
+	unsigned int &newDivisor, unsigned int &newRange) const
+{
+	if (minResolution == 0 || minResolution > maxRange || !(newFrequency > 0.0))
+		return false;
 
 	if (mode == PWMMode::MarkSpace)
 	{
-		const unsigned int rangeDivisorProduct = floor(pwmClockFrequency / newFrequency + 0.5);
-		divisor = 1;
+		const double rangeDivisorProduct(pwmClockFrequency / newFrequency);
 
 		// Make sure the frequency is within the range we can attempt
 		if (rangeDivisorProduct / minResolution < minClockDivisor ||// Frequency too high
 			rangeDivisorProduct / maxClockDivisor > maxRange)// Frequency too low
 			return false;
 
-		unsigned int i(1);
-		while (divisor < 2 || newRange > maxRange ||
-			divisor > maxClockDivisor || newRange < minResolution)
-		{
-			// If we've tried all combinations, we're done
-			if (i >= 2 * rangeDivisorProduct)
-				return false;
-
-			if (i % 2 == 0)
-				divisor = GetMinimumAcceptableFactor(rangeDivisorProduct + floor(i / 2.0));
-			else
-				divisor = GetMinimumAcceptableFactor(rangeDivisorProduct - floor(i / 2.0));
-			i++;
-
-			newRange = floor(rangeDivisorProduct / divisor + 0.5);
-		}
+		if (!FindDivisorAndRange(newFrequency, minResolution, newDivisor, newRange))
+			return false;
 	}
 	else
 	{
@@ -216,39 +274,166 @@ bool PWMOutput::SetFrequency(double newFrequency, unsigned int minResolution)
 		return false;
 	}
 
-	assert(divisor >= minClockDivisor &&
-		divisor <= maxClockDivisor &&
-		newRange >= minResolution);
+	assert(newDivisor >= minClockDivisor &&
+		newDivisor <= maxClockDivisor &&
+		newRange >= minResolution &&
+		newRange <= maxRange);
 
-	pwmSetClock(divisor);
-	SetRange(newRange);
+	return true;
+}
 
-	frequency = pwmClockFrequency / (double)divisor / (double)newRange;
+//==========================================================================
+// Class:			PWMOutput
+// Function:		FindDivisorAndRange
+//
+// Description:		Finds the clock divisor and range (at least minResolution)
+//					giving the frequency closest to the one specified.  For
+//					each divisor, only the two ranges on either side of the
+//					exact (non-integer) solution can be best, so at most one
+//					pass over the allowable divisors is required (a few
+//					thousand operations in the worst case).  If several pairs
+//					are equally close, the one with the smallest divisor (and
+//					so the highest range) is chosen.
+//
+// Input Arguments:
+//		targetFrequency	= const double& [Hz]
+//		minResolution	= const unsigned int&
+//
+// Output Arguments:
+//		divisor			= unsigned int&
+//		range			= unsigned int&
+//
+// Return Value:
+//		bool, true if a pair was found, false otherwise
+//
+//==========================================================================
+bool PWMOutput::FindDivisorAndRange(const double &targetFrequency,
+	const unsigned int &minResolution, unsigned int &divisor, unsigned int &range)
+{
+	if (minResolution == 0 || minResolution > maxRange || !(targetFrequency > 0.0))
+		return false;
 
-	return true;
+	const double rangeDivisorProduct(pwmClockFrequency / targetFrequency);
+
+	// Divisors outside of these limits can only produce ranges beyond
+	// [minResolution, maxRange], which are further from the target
+	const double lowestDivisor(std::max(static_cast<double>(minClockDivisor), floor(rangeDivisorProduct / maxRange)));
+	const double highestDivisor(std::min(static_cast<double>(maxClockDivisor), floor(rangeDivisorProduct / minResolution) + 1.0));
+	if (lowestDivisor > highestDivisor)
+		return false;
+
+	const unsigned int firstDivisor(lowestDivisor);
+	const unsigned int lastDivisor(highestDivisor);
+
+	double bestError(std::numeric_limits<double>::infinity());
+	unsigned int d;
+	for (d = firstDivisor; d <= lastDivisor && bestError > 0.0; d++)
+	{
+		const double exactRange(rangeDivisorProduct / d);
+		const double candidates[2] = {floor(exactRange), ceil(exactRange)};
+		for (const double& candidate : candidates)
+		{
+			const unsigned int r(std::min(std::max(candidate, static_cast<double>(minResolution)),
+				static_cast<double>(maxRange)));
+			const double error(fabs(pwmClockFrequency / (static_cast<double>(d) * r) - targetFrequency));
+			if (error < bestError)
+			{
+				bestError = error;
+				divisor = d;
+				range = r;
+			}
+		}
+	}
+
+	return bestError != std::numeric_limits<double>::infinity();
 }
 
 //==========================================================================
 // Class:			PWMOutput
-// Function:		GetMinimumAcceptableFactor
+// Function:		UpdateSharedSettings
 //
-// Description:		Returns the smallest prime factor of the argument.
+// Description:		Records a new clock divisor and range in every output
+//					driven by the specified backend, since the hardware
+//					channels share them.  The value written to each output is
+//					not changed, so its duty cycle is recomputed against the
+//					new range (callers that want to keep a duty cycle must
+//					write it again).
 //
 // Input Arguments:
-//		i	= unsigned int
+//		backend		= PWMBackend&
+//		newDivisor	= const unsigned int&
+//		newRange	= const unsigned int&
 //
 // Output Arguments:
 //		None
 //
 // Return Value:
-//		unsigned int
+//		None
 //
 //==========================================================================
-unsigned int PWMOutput::GetMinimumAcceptableFactor(unsigned int i) const
+void PWMOutput::UpdateSharedSettings(PWMBackend &backend,
+	const unsigned int &newDivisor, const unsigned int &newRange)
 {
-	// We're going to use a naieve approach with special stop condition
-	unsigned int f(1);
-	while (f++, (i % f != 0 || i / f > maxRange) && f <= maxClockDivisor) {}
+	std::lock_guard<std::mutex> lock(outputsMutex);
+	for (auto& output : outputs)
+	{
+		if (&output->pwmBackend != &backend)
+			continue;
+
+		output->divisor = newDivisor;
+		output->range = newRange;
+		if (newRange > 0)
+			output->duty = std::min(static_cast<double>(output->writtenValue) / newRange, 1.0);
+		if (newDivisor > 0 && newRange > 0)
+			output->frequency = pwmClockFrequency / (double)newDivisor / (double)newRange;
+	}
+}
 
-	return f;
+//==========================================================================
+// Class:			PWMOutput
+// Function:		GetDefaultPWMBackend
+//
+// Description:		Returns the PWM backend used when none is specified at
+//					construction.  Unless another backend was selected with
+//					SetDefaultPWMBackend, this is Wiring Pi.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		PWMBackend&
+//
+//==========================================================================
+PWMBackend& PWMOutput::GetDefaultPWMBackend()
+{
+	if (defaultPWMBackend)
+		return *defaultPWMBackend;
+
+	static WiringPiPWMBackend wiringPiBackend;
+	return wiringPiBackend;
+}
+
+//==========================================================================
+// Class:			PWMOutput
+// Function:		SetDefaultPWMBackend
+//
+// Description:		Selects the PWM backend used by objects constructed
+//					without one.  The backend must outlive those objects.
+//
+// Input Arguments:
+//		backend	= PWMBackend&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PWMOutput::SetDefaultPWMBackend(PWMBackend &backend)
+{
+	defaultPWMBackend = &backend;
 }
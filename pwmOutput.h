@@ -7,9 +7,15 @@
 #ifndef PWM_OUTPUT_H_
 #define PWM_OUTPUT_H_
 
+// Standard C++ headers
+#include <vector>
+#include <mutex>
+
 // Local headers
 #include "gpio.h"
 
+class PWMBackend;
+
 class PWMOutput : public GPIO
 {
 public:
@@ -19,7 +25,13 @@ public:
 		MarkSpace
 	};
 
-	PWMOutput(int pin = 1, PWMMode mode = PWMMode::MarkSpace);
+	PWMOutput(int pin = 1, PWMMode mode = PWMMode::MarkSpace,
+		PWMBackend &pwmBackend = GetDefaultPWMBackend(),
+		GPIOBackend &gpioBackend = GetDefaultBackend());
+	PWMOutput(const PWMOutput&) = delete;
+	virtual ~PWMOutput();
+
+	PWMOutput& operator=(const PWMOutput&) = delete;
 
 	void SetDutyCycle(double newDuty);
 	void SetMode(PWMMode newMode);
@@ -29,15 +41,38 @@ public:
 	double GetDutyCycle() const { return duty; }
 	double GetFrequency() const { return frequency; }
 
+	static PWMBackend& GetDefaultPWMBackend();
+	static void SetDefaultPWMBackend(PWMBackend &backend);
+
+	// Computes the settings SetFrequency would use, without changing anything
+	static bool FindDivisorAndRange(const double &targetFrequency,
+		const unsigned int &minResolution, unsigned int &divisor, unsigned int &range);
+
 private:
 	static const double pwmClockFrequency;// [Hz]
 	static const unsigned int minClockDivisor, maxClockDivisor, maxRange;
 	double frequency;// [Hz]
 	double duty;// [%]
 	unsigned int range;
+	unsigned int divisor;
+	unsigned int writtenValue;// Most recent value sent to the backend
 	PWMMode mode;
 
-	unsigned int GetMinimumAcceptableFactor(unsigned int i) const;
+	PWMBackend &pwmBackend;
+	static PWMBackend *defaultPWMBackend;
+
+	// Every output, so that all of those sharing a backend see changes to
+	// the (shared) clock divisor and range
+	static std::vector<PWMOutput*> outputs;
+	static std::mutex outputsMutex;
+
+	static void UpdateSharedSettings(PWMBackend &backend,
+		const unsigned int &newDivisor, const unsigned int &newRange);
+
+	bool ComputeDivisorAndRange(const double &newFrequency, const unsigned int &minResolution,
+		unsigned int &newDivisor, unsigned int &newRange) const;
+
+	friend class PWMTransaction;
 };
 
 #endif// PWM_OUTPUT_H_
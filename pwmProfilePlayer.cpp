@@ -0,0 +1,414 @@
+// File:  pwmProfilePlayer.cpp
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  Plays precomputed duty-cycle profiles (ramps, waveforms, etc.) on a
+//        PWMOutput from a dedicated worker thread.  Each sample is written at
+//        an absolute deadline, so timing errors don't accumulate; samples
+//        that can no longer be written on time are skipped and counted.
+
+// Standard C/C++ headers
+#include <cstring>
+#include <algorithm>
+
+// *nix standard headers
+#include <pthread.h>
+#include <sched.h>
+
+// Local headers
+#include "pwmProfilePlayer.h"
+
+//==========================================================================
+// Class:			PWMProfilePlayer
+// Function:		PWMProfilePlayer
+//
+// Description:		Constructor for PWMProfilePlayer class.
+//
+// Input Arguments:
+//		output				= PWMOutput&
+//		realTimePriority	= const int&
+//		outStream			= std::ostream&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+PWMProfilePlayer::PWMProfilePlayer(PWMOutput &output, const int &realTimePriority,
+	std::ostream &outStream) : output(output), outStream(outStream), playing(false),
+	generation(0), stopThread(false)
+{
+	workerThread = std::thread(&PWMProfilePlayer::WorkerThreadEntry, this);
+
+	if (realTimePriority > 0)
+	{
+		sched_param parameters;
+		memset(&parameters, 0, sizeof(parameters));
+		parameters.sched_priority = realTimePriority;
+		const int result(pthread_setschedparam(workerThread.native_handle(), SCHED_FIFO, &parameters));
+		if (result != 0)
+			outStream << "Failed to set real-time priority:  " << strerror(result) << std::endl;
+	}
+}
+
+//==========================================================================
+// Class:			PWMProfilePlayer
+// Function:		~PWMProfilePlayer
+//
+// Description:		Destructor for PWMProfilePlayer class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+PWMProfilePlayer::~PWMProfilePlayer()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopThread = true;
+	}
+
+	queueChanged.notify_all();
+	workerThread.join();
+}
+
+//==========================================================================
+// Class:			PWMProfilePlayer
+// Function:		Play
+//
+// Description:		Discards anything playing or queued and starts playing
+//					the specified profile.
+//
+// Input Arguments:
+//		profile	= const Profile&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false if the profile is invalid
+//
+//==========================================================================
+bool PWMProfilePlayer::Play(const Profile &profile)
+{
+	if (!ProfileOK(profile))
+		return false;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		queue.clear();
+		queue.push_back(profile);
+		playing = true;
+		generation++;
+	}
+
+	queueChanged.notify_all();
+	return true;
+}
+
+//==========================================================================
+// Class:			PWMProfilePlayer
+// Function:		Queue
+//
+// Description:		Adds the specified profile to the end of the queue.
+//
+// Input Arguments:
+//		profile	= const Profile&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false if the profile is invalid
+//
+//==========================================================================
+bool PWMProfilePlayer::Queue(const Profile &profile)
+{
+	if (!ProfileOK(profile))
+		return false;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		queue.push_back(profile);
+		playing = true;
+	}
+
+	queueChanged.notify_all();
+	return true;
+}
+
+//==========================================================================
+// Class:			PWMProfilePlayer
+// Function:		Stop
+//
+// Description:		Stops playback and discards all queued profiles.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PWMProfilePlayer::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		queue.clear();
+		generation++;
+	}
+
+	queueChanged.notify_all();
+}
+
+//==========================================================================
+// Class:			PWMProfilePlayer
+// Function:		IsPlaying
+//
+// Description:		Returns true if a profile is playing or queued.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool
+//
+//==========================================================================
+bool PWMProfilePlayer::IsPlaying() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return playing;
+}
+
+//==========================================================================
+// Class:			PWMProfilePlayer
+// Function:		WaitForCompletion
+//
+// Description:		Blocks until all profiles have finished (or been
+//					stopped), or until the timeout expires.
+//
+// Input Arguments:
+//		timeout	= const std::chrono::milliseconds&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if playback is complete, false on timeout
+//
+//==========================================================================
+bool PWMProfilePlayer::WaitForCompletion(const std::chrono::milliseconds &timeout)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	return playbackComplete.wait_for(lock, timeout, [this]()
+	{
+		return !playing;
+	});
+}
+
+//==========================================================================
+// Class:			PWMProfilePlayer
+// Function:		GetStatistics
+//
+// Description:		Returns a copy of the playback statistics.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Statistics
+//
+//==========================================================================
+PWMProfilePlayer::Statistics PWMProfilePlayer::GetStatistics() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return statistics;
+}
+
+//==========================================================================
+// Class:			PWMProfilePlayer
+// Function:		ResetStatistics
+//
+// Description:		Clears the playback statistics.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PWMProfilePlayer::ResetStatistics()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	statistics = Statistics();
+}
+
+//==========================================================================
+// Class:			PWMProfilePlayer
+// Function:		WorkerThreadEntry
+//
+// Description:		Entry point for the worker thread.  Plays queued profiles
+//					back-to-back; a profile that follows another without a
+//					gap keeps the previous profile's timeline.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PWMProfilePlayer::WorkerThreadEntry()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	Clock::time_point startTime;
+	bool chained(false);
+
+	while (!stopThread)
+	{
+		if (queue.empty())
+		{
+			chained = false;
+			if (playing)
+			{
+				playing = false;
+				playbackComplete.notify_all();
+			}
+
+			queueChanged.wait(lock);
+			continue;
+		}
+
+		const Profile profile(std::move(queue.front()));
+		queue.pop_front();
+
+		if (!chained)
+			startTime = Clock::now();
+
+		chained = PlayProfile(lock, profile, startTime);
+		if (chained)
+			statistics.profilesCompleted++;
+	}
+}
+
+//==========================================================================
+// Class:			PWMProfilePlayer
+// Function:		PlayProfile
+//
+// Description:		Writes each sample of the profile at its deadline.  If a
+//					later sample is already due when we wake up, the samples
+//					before it are skipped.  The lock is released while
+//					sleeping and while writing to the output.
+//
+// Input Arguments:
+//		lock		= std::unique_lock<std::mutex>&, must own the lock
+//		profile		= const Profile&
+//		startTime	= Clock::time_point&, deadline for the first sample
+//
+// Output Arguments:
+//		startTime	= Clock::time_point&, deadline for the sample after the last
+//
+// Return Value:
+//		bool, true if the profile completed, false if it was abandoned
+//
+//==========================================================================
+bool PWMProfilePlayer::PlayProfile(std::unique_lock<std::mutex> &lock,
+	const Profile &profile, Clock::time_point &startTime)
+{
+	const uint64_t startGeneration(generation);
+	const Clock::duration period(std::chrono::duration_cast<Clock::duration>(profile.samplePeriod));
+	const uint64_t sampleCount(profile.samples.size());
+	const uint64_t totalCount(sampleCount * profile.repeatCount);// Zero if repeating indefinitely
+
+	uint64_t index(0);
+	while (true)
+	{
+		if ((totalCount > 0 && index >= totalCount) ||
+			(totalCount == 0 && index > 0 && index % sampleCount == 0 && !queue.empty()))
+		{
+			startTime += period * static_cast<Clock::rep>(index);
+			return true;
+		}
+
+		if (queueChanged.wait_until(lock, startTime + period * static_cast<Clock::rep>(index), [this, startGeneration]()
+		{
+			return stopThread || generation != startGeneration;
+		}))
+			return false;
+
+		const Clock::time_point now(Clock::now());
+		uint64_t dueIndex((now - startTime) / period);
+		if (totalCount > 0)
+			dueIndex = std::min(dueIndex, totalCount - 1);
+
+		if (dueIndex > index)
+		{
+			statistics.missedDeadlines += dueIndex - index;
+			index = dueIndex;
+		}
+
+		statistics.maxLateness = std::max(statistics.maxLateness, now - (startTime + period * static_cast<Clock::rep>(index)));
+
+		const double duty(profile.samples[index % sampleCount]);
+		lock.unlock();
+		output.SetDutyCycle(duty);
+		lock.lock();
+
+		statistics.samplesWritten++;
+		index++;
+	}
+}
+
+//==========================================================================
+// Class:			PWMProfilePlayer
+// Function:		ProfileOK
+//
+// Description:		Checks the profile for validity.
+//
+// Input Arguments:
+//		profile	= const Profile&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the profile can be played
+//
+//==========================================================================
+bool PWMProfilePlayer::ProfileOK(const Profile &profile)
+{
+	if (profile.samples.empty() || profile.samplePeriod <= std::chrono::nanoseconds::zero())
+		return false;
+
+	for (const auto& sample : profile.samples)
+	{
+		if (sample < 0.0 || sample > 1.0)
+			return false;
+	}
+
+	return true;
+}
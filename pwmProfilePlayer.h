@@ -0,0 +1,93 @@
+// File:  pwmProfilePlayer.h
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  Plays precomputed duty-cycle profiles (ramps, waveforms, etc.) on a
+//        PWMOutput from a dedicated worker thread.  Each sample is written at
+//        an absolute deadline, so timing errors don't accumulate; samples
+//        that can no longer be written on time are skipped and counted.
+
+#ifndef PWM_PROFILE_PLAYER_H_
+#define PWM_PROFILE_PLAYER_H_
+
+// Standard C++ headers
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <iostream>
+#include <cstdint>
+
+// Local headers
+#include "pwmOutput.h"
+
+class PWMProfilePlayer
+{
+public:
+	// If realTimePriority is greater than zero, the worker thread is run
+	// with the SCHED_FIFO policy at that priority (requires privileges)
+	PWMProfilePlayer(PWMOutput &output, const int &realTimePriority = 0,
+		std::ostream &outStream = std::cout);
+	~PWMProfilePlayer();
+
+	struct Profile
+	{
+		std::vector<double> samples;// Duty cycles, 0.0 to 1.0
+		std::chrono::nanoseconds samplePeriod;
+
+		// Zero repeats until Stop is called, or until another profile is
+		// queued (the current pass is completed first)
+		unsigned int repeatCount = 1;
+	};
+
+	// Replaces anything playing or queued, and starts right away
+	bool Play(const Profile &profile);
+
+	// Starts when everything before it has finished, exactly one sample
+	// period after the last sample of the previous profile
+	bool Queue(const Profile &profile);
+
+	// The output is left at the most recently written duty cycle
+	void Stop();
+
+	bool IsPlaying() const;
+	bool WaitForCompletion(const std::chrono::milliseconds &timeout);
+
+	typedef std::chrono::steady_clock Clock;
+
+	struct Statistics
+	{
+		uint64_t samplesWritten = 0;
+		uint64_t missedDeadlines = 0;// Samples skipped because they were too late
+		uint64_t profilesCompleted = 0;
+		Clock::duration maxLateness = Clock::duration::zero();
+	};
+
+	Statistics GetStatistics() const;
+	void ResetStatistics();
+
+private:
+	PWMOutput &output;
+	std::ostream &outStream;
+
+	mutable std::mutex mutex;
+	std::condition_variable queueChanged;
+	std::condition_variable playbackComplete;
+	std::deque<Profile> queue;
+	bool playing;
+	uint64_t generation;// Incremented by Play and Stop to abandon the current profile
+	bool stopThread;
+
+	Statistics statistics;
+
+	std::thread workerThread;
+
+	void WorkerThreadEntry();
+	bool PlayProfile(std::unique_lock<std::mutex> &lock, const Profile &profile, Clock::time_point &startTime);
+
+	static bool ProfileOK(const Profile &profile);
+};
+
+#endif// PWM_PROFILE_PLAYER_H_
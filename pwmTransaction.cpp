@@ -0,0 +1,217 @@
+// File:  pwmTransaction.cpp
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  Stages changes to several hardware PWM outputs and applies them
+//        together.  All calculations are done first, and then only the
+//        registers that actually change are written, back-to-back.  This is
+//        a best-effort reduction of the time between the writes:  they are
+//        not synchronized with the PWM period, so a period boundary can
+//        still fall between two of them.
+
+// Standard C++ headers
+#include <cassert>
+
+// Local headers
+#include "pwmTransaction.h"
+#include "pwmBackend.h"
+
+//==========================================================================
+// Class:			PWMTransaction
+// Function:		PWMTransaction
+//
+// Description:		Constructor for PWMTransaction class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+PWMTransaction::PWMTransaction() : range(0), frequency(0.0), minResolution(0)
+{
+	Clear();
+}
+
+//==========================================================================
+// Class:			PWMTransaction
+// Function:		SetDutyCycle
+//
+// Description:		Stages a new duty cycle for the specified output.
+//
+// Input Arguments:
+//		output	= PWMOutput&
+//		duty	= const double&, must range from 0.0 to 1.0
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PWMTransaction::SetDutyCycle(PWMOutput &output, const double &duty)
+{
+	assert(duty >= 0.0 && duty <= 1.0);
+	assert(entries.empty() || &entries.front().output->pwmBackend == &output.pwmBackend);
+
+	for (auto& entry : entries)
+	{
+		if (entry.output == &output)
+		{
+			entry.duty = duty;
+			return;
+		}
+	}
+
+	Entry entry;
+	entry.output = &output;
+	entry.duty = duty;
+	entries.push_back(entry);
+}
+
+//==========================================================================
+// Class:			PWMTransaction
+// Function:		SetRange
+//
+// Description:		Stages a new range.  Replaces any staged frequency.
+//
+// Input Arguments:
+//		range	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PWMTransaction::SetRange(const unsigned int &range)
+{
+	assert(range <= PWMOutput::maxRange);
+
+	this->range = range;
+	rangeStaged = true;
+	frequencyStaged = false;
+}
+
+//==========================================================================
+// Class:			PWMTransaction
+// Function:		SetFrequency
+//
+// Description:		Stages a new frequency.  Replaces any staged range.
+//
+// Input Arguments:
+//		frequency		= const double& [Hz]
+//		minResolution	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PWMTransaction::SetFrequency(const double &frequency, const unsigned int &minResolution)
+{
+	this->frequency = frequency;
+	this->minResolution = minResolution;
+	frequencyStaged = true;
+	rangeStaged = false;
+}
+
+//==========================================================================
+// Class:			PWMTransaction
+// Function:		Commit
+//
+// Description:		Applies the staged changes.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool PWMTransaction::Commit()
+{
+	if (entries.empty())
+	{
+		Clear();
+		return !frequencyStaged && !rangeStaged;
+	}
+
+	PWMOutput& first(*entries.front().output);
+	unsigned int newDivisor(first.divisor);
+	unsigned int newRange(first.range);
+	if (frequencyStaged)
+	{
+		if (!first.ComputeDivisorAndRange(frequency, minResolution, newDivisor, newRange))
+		{
+			Clear();
+			return false;
+		}
+	}
+	else if (rangeStaged)
+		newRange = range;
+
+	std::vector<unsigned int> values(entries.size());
+	unsigned int i;
+	for (i = 0; i < entries.size(); i++)
+		values[i] = entries[i].duty * newRange;
+
+	// No calculations from here on, to keep the writes as close together as possible
+	PWMBackend& backend(first.pwmBackend);
+	if (newDivisor != first.divisor)
+		backend.SetClockDivisor(newDivisor);
+	if (newRange != first.range)
+		backend.SetRange(newRange);
+	for (i = 0; i < entries.size(); i++)
+	{
+		if (values[i] != entries[i].output->writtenValue)
+			backend.Write(entries[i].output->pin, values[i]);
+	}
+
+	// Outputs that share the backend but were not in the transaction have
+	// the new divisor and range, too
+	PWMOutput::UpdateSharedSettings(backend, newDivisor, newRange);
+	for (i = 0; i < entries.size(); i++)
+	{
+		PWMOutput& output(*entries[i].output);
+		output.duty = entries[i].duty;
+		output.writtenValue = values[i];
+	}
+
+	Clear();
+	return true;
+}
+
+//==========================================================================
+// Class:			PWMTransaction
+// Function:		Clear
+//
+// Description:		Discards all staged changes.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void PWMTransaction::Clear()
+{
+	entries.clear();
+	rangeStaged = false;
+	frequencyStaged = false;
+}
@@ -0,0 +1,60 @@
+// File:  pwmTransaction.h
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  Stages changes to several hardware PWM outputs and applies them
+//        together.  All calculations are done first, and then only the
+//        registers that actually change are written, back-to-back.  This is
+//        a best-effort reduction of the time between the writes:  they are
+//        not synchronized with the PWM period, so a period boundary can
+//        still fall between two of them.
+
+#ifndef PWM_TRANSACTION_H_
+#define PWM_TRANSACTION_H_
+
+// Standard C++ headers
+#include <vector>
+
+// Local headers
+#include "pwmOutput.h"
+
+class PWMTransaction
+{
+public:
+	PWMTransaction();
+
+	void SetDutyCycle(PWMOutput &output, const double &duty);
+
+	// Both hardware channels share the clock divisor and range, so these
+	// apply to every output in the transaction.  Outputs whose duty cycle
+	// should be kept (rescaled to the new range) must be added with
+	// SetDutyCycle as well.
+	void SetRange(const unsigned int &range);
+	void SetFrequency(const double &frequency, const unsigned int &minResolution = 100);
+
+	// Nothing is written if the staged frequency cannot be achieved.  The
+	// staged changes are cleared either way.  Other outputs on the same
+	// backend are updated with the new divisor and range, and report the
+	// duty cycle their unchanged values now give.
+	bool Commit();
+
+private:
+	struct Entry
+	{
+		PWMOutput *output;
+		double duty;
+	};
+
+	std::vector<Entry> entries;
+
+	bool rangeStaged;
+	unsigned int range;
+
+	bool frequencyStaged;
+	double frequency;// [Hz]
+	unsigned int minResolution;
+
+	void Clear();
+};
+
+#endif// PWM_TRANSACTION_H_
@@ -0,0 +1,1532 @@
+// File:  simulatedBoard.cpp
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  Software model of a Raspberry Pi, for running and benchmarking code
+//        that uses the classes in this repository on machines without the
+//        real hardware.  Provides virtual GPIO pins (with interrupts), a
+//        virtual PWM peripheral, virtual I2C buses and a fake 1-wire sysfs
+//        tree that the DS18B20 class can read.
+
+// Standard C/C++ headers
+#include <cassert>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <algorithm>
+
+// *nix standard headers
+#include <sys/stat.h>
+#include <sys/inotify.h>
+#include <sys/eventfd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+// Local headers
+#include "simulatedBoard.h"
+#include "twi.h"
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		Constant definitions
+//
+// Description:		Constant definitions for SimulatedBoard class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const unsigned int SimulatedBoard::pinCount = 64;
+const double SimulatedBoard::pwmClockFrequency = 19.2e6;// [Hz]
+thread_local Interrupt *SimulatedBoard::deliveringInterrupt(nullptr);
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		SimulatedBoard
+//
+// Description:		Constructor for SimulatedBoard class.
+//
+// Input Arguments:
+//		w1Directory	= const std::string&, location of the fake 1-wire device
+//					  tree (use in place of /sys/bus/w1/devices/); leave empty
+//					  if not needed
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+SimulatedBoard::SimulatedBoard(const std::string& w1Directory) : pins(pinCount),
+	w1Directory(w1Directory.empty() || w1Directory.back() == '/' ? w1Directory : w1Directory + "/"),
+	conversionTime(750), w1StopFileDescriptor(-1)
+{
+	if (this->w1Directory.empty())
+		return;
+
+	mkdir(this->w1Directory.c_str(), 0755);
+	mkdir((this->w1Directory + "w1_bus_master1").c_str(), 0755);
+	UpdateW1MasterSlaveList();
+
+	// No bulk conversion pending
+	if (!WriteW1BulkReadStatus("0"))
+		return;
+
+	// Watch for triggers written to the bulk read attribute
+	const int inotifyFileDescriptor(inotify_init1(IN_CLOEXEC));
+	if (inotifyFileDescriptor == -1)
+		return;
+
+	w1StopFileDescriptor = eventfd(0, EFD_CLOEXEC);
+	if (w1StopFileDescriptor == -1 || inotify_add_watch(inotifyFileDescriptor,
+		(this->w1Directory + "w1_bus_master1/therm_bulk_read").c_str(), IN_MODIFY) == -1)
+	{
+		close(inotifyFileDescriptor);
+		if (w1StopFileDescriptor != -1)
+			close(w1StopFileDescriptor);
+		w1StopFileDescriptor = -1;
+		return;
+	}
+
+	w1Thread = std::thread(&SimulatedBoard::W1ThreadEntry, this, inotifyFileDescriptor);
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		~SimulatedBoard
+//
+// Description:		Destructor for SimulatedBoard class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+SimulatedBoard::~SimulatedBoard()
+{
+	if (!w1Thread.joinable())
+		return;
+
+	const uint64_t stop(1);
+	if (write(w1StopFileDescriptor, &stop, sizeof(stop)) == sizeof(stop))
+		w1Thread.join();
+	else
+		w1Thread.detach();
+	close(w1StopFileDescriptor);
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		MakeDefault
+//
+// Description:		Makes this board the default backend for GPIO, PWMOutput
+//					and TWI objects, so existing code runs on it unchanged.
+//					The board must outlive every object created afterwards.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SimulatedBoard::MakeDefault()
+{
+	GPIO::SetDefaultBackend(*this);
+	PWMOutput::SetDefaultPWMBackend(*this);
+	TWI::SetDefaultBackend(*this);
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		GetPin
+//
+// Description:		Returns the state of the specified virtual pin.
+//
+// Input Arguments:
+//		pin	= const int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Pin&
+//
+//==========================================================================
+SimulatedBoard::Pin& SimulatedBoard::GetPin(const int &pin)
+{
+	assert(pin >= 0 && pin < static_cast<int>(pinCount));
+	return pins[pin];
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		GetPin
+//
+// Description:		Returns the state of the specified virtual pin.
+//
+// Input Arguments:
+//		pin	= const int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		const Pin&
+//
+//==========================================================================
+const SimulatedBoard::Pin& SimulatedBoard::GetPin(const int &pin) const
+{
+	assert(pin >= 0 && pin < static_cast<int>(pinCount));
+	return pins[pin];
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		GetLevel
+//
+// Description:		Returns the logic level present on a virtual pin.
+//
+// Input Arguments:
+//		pin	= const Pin&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for high
+//
+//==========================================================================
+bool SimulatedBoard::GetLevel(const Pin &pin)
+{
+	if (pin.direction != GPIO::DataDirection::Input)
+		return pin.outputLevel;
+	else if (pin.externallyDriven)
+		return pin.externalLevel;
+
+	return pin.pull == GPIO::PullResistance::PullUp;
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		EdgeTriggers
+//
+// Description:		Checks whether a change in level should trigger the
+//					pin's interrupt.
+//
+// Input Arguments:
+//		pin			= const Pin&
+//		oldLevel	= const bool&, level before the change
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the interrupt should be called
+//
+//==========================================================================
+bool SimulatedBoard::EdgeTriggers(const Pin &pin, const bool &oldLevel)
+{
+	const bool newLevel(GetLevel(pin));
+	if (!pin.interrupt || newLevel == oldLevel)
+		return false;
+
+	if (pin.edge == Interrupt::EdgeDirection::Rising)
+		return newLevel;
+	else if (pin.edge == Interrupt::EdgeDirection::Falling)
+		return !newLevel;
+
+	return true;
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		StartDelivery
+//
+// Description:		Returns the interrupt attached to the pin (if any), and
+//					counts the call to it as in progress, so that
+//					DetachInterrupt waits for it.  Caller must hold the lock
+//					and, if the return value is not nullptr, must then call
+//					DeliverEdge.
+//
+// Input Arguments:
+//		pin	= Pin&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Interrupt*
+//
+//==========================================================================
+Interrupt* SimulatedBoard::StartDelivery(Pin &pin)
+{
+	if (pin.interrupt)
+		pin.deliveries++;
+	return pin.interrupt;
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		DeliverEdge
+//
+// Description:		Calls an interrupt returned by StartDelivery.  Must be
+//					called without holding the lock, so the service routine
+//					may use the board.
+//
+// Input Arguments:
+//		pin			= const int&
+//		interrupt	= Interrupt&
+//		rising		= const bool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SimulatedBoard::DeliverEdge(const int &pin, Interrupt &interrupt, const bool &rising)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		statistics.interruptsDelivered++;
+	}
+
+	// Service routines may drive other pins, so deliveries can nest
+	Interrupt *outerInterrupt(deliveringInterrupt);
+	deliveringInterrupt = &interrupt;
+	interrupt.HandleEdge(rising, Interrupt::Clock::now());
+	deliveringInterrupt = outerInterrupt;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		GetPin(pin).deliveries--;
+	}
+
+	deliveryComplete.notify_all();
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		SetDataDirection
+//
+// Description:		Sets the data direction for the virtual pin.
+//
+// Input Arguments:
+//		pin			= const int&
+//		direction	= const GPIO::DataDirection&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SimulatedBoard::SetDataDirection(const int &pin, const GPIO::DataDirection &direction)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	GetPin(pin).direction = direction;
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		SetPullUpDown
+//
+// Description:		Sets the pull resistor for the virtual pin.  An undriven
+//					input follows its pull resistor.
+//
+// Input Arguments:
+//		pin		= const int&
+//		state	= const GPIO::PullResistance&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SimulatedBoard::SetPullUpDown(const int &pin, const GPIO::PullResistance &state)
+{
+	Interrupt *interrupt(nullptr);
+	bool level;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		Pin& p(GetPin(pin));
+		const bool oldLevel(GetLevel(p));
+		p.pull = state;
+		level = GetLevel(p);
+		if (EdgeTriggers(p, oldLevel))
+			interrupt = StartDelivery(p);
+	}
+
+	if (interrupt)
+		DeliverEdge(pin, *interrupt, level);
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		SetOutput
+//
+// Description:		Sets the state of the virtual output pin.
+//
+// Input Arguments:
+//		pin		= const int&
+//		high	= const bool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SimulatedBoard::SetOutput(const int &pin, const bool &high)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	GetPin(pin).outputLevel = high;
+	statistics.pinWrites++;
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		GetInput
+//
+// Description:		Reads the level of the virtual pin.
+//
+// Input Arguments:
+//		pin	= const int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for high
+//
+//==========================================================================
+bool SimulatedBoard::GetInput(const int &pin)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	statistics.pinReads++;
+	return GetLevel(GetPin(pin));
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		SetOutputs
+//
+// Description:		Sets the state of several virtual output pins at once.
+//
+// Input Arguments:
+//		pins	= const std::vector<int>&
+//		values	= const uint32_t&, bit i is the desired state of pins[i]
+//		mask	= const uint32_t&, only pins with the corresponding bit set
+//				  are changed
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SimulatedBoard::SetOutputs(const std::vector<int> &pins, const uint32_t &values, const uint32_t &mask)
+{
+	assert(pins.size() <= 32);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	unsigned int i;
+	for (i = 0; i < pins.size(); i++)
+	{
+		if (mask & (1u << i))
+			GetPin(pins[i]).outputLevel = (values & (1u << i)) != 0;
+	}
+
+	statistics.pinWrites++;
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		GetInputs
+//
+// Description:		Reads the level of several virtual pins at once.
+//
+// Input Arguments:
+//		pins	= const std::vector<int>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		uint32_t, bit i is set if pins[i] is high
+//
+//==========================================================================
+uint32_t SimulatedBoard::GetInputs(const std::vector<int> &pins)
+{
+	assert(pins.size() <= 32);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	uint32_t values(0);
+	unsigned int i;
+	for (i = 0; i < pins.size(); i++)
+	{
+		if (GetLevel(GetPin(pins[i])))
+			values |= 1u << i;
+	}
+
+	statistics.pinReads++;
+	return values;
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		AttachInterrupt
+//
+// Description:		Attaches an interrupt to a virtual pin.
+//
+// Input Arguments:
+//		interrupt	= Interrupt&
+//		edge		= const Interrupt::EdgeDirection&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false if the pin already has an interrupt
+//
+//==========================================================================
+bool SimulatedBoard::AttachInterrupt(Interrupt &interrupt, const Interrupt::EdgeDirection &edge)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	Pin& p(GetPin(interrupt.GetPin()));
+	if (p.interrupt && p.interrupt != &interrupt)
+		return false;
+
+	p.interrupt = &interrupt;
+	p.edge = edge;
+	return true;
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		DetachInterrupt
+//
+// Description:		Detaches an interrupt from a virtual pin.  Waits for
+//					calls to its service routine that are in progress on
+//					other threads, unless called from the service routine
+//					itself.
+//
+// Input Arguments:
+//		interrupt	= Interrupt&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SimulatedBoard::DetachInterrupt(Interrupt &interrupt)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	Pin& p(GetPin(interrupt.GetPin()));
+	if (p.interrupt != &interrupt)
+		return;
+
+	p.interrupt = nullptr;
+	if (deliveringInterrupt == &interrupt)
+		return;
+
+	deliveryComplete.wait(lock, [&p]()
+	{
+		return p.deliveries == 0;
+	});
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		DriveInput
+//
+// Description:		Drives a virtual pin from outside the board, as a
+//					connected device would.  Any interrupt triggered by the
+//					change is called before this method returns.
+//
+// Input Arguments:
+//		pin		= const int&
+//		high	= const bool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SimulatedBoard::DriveInput(const int &pin, const bool &high)
+{
+	Interrupt *interrupt(nullptr);
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		Pin& p(GetPin(pin));
+		const bool oldLevel(GetLevel(p));
+		p.externallyDriven = true;
+		p.externalLevel = high;
+		if (EdgeTriggers(p, oldLevel))
+			interrupt = StartDelivery(p);
+	}
+
+	if (interrupt)
+		DeliverEdge(pin, *interrupt, high);
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		ReleaseInput
+//
+// Description:		Stops driving a virtual pin from outside the board.
+//
+// Input Arguments:
+//		pin	= const int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SimulatedBoard::ReleaseInput(const int &pin)
+{
+	Interrupt *interrupt(nullptr);
+	bool level;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		Pin& p(GetPin(pin));
+		const bool oldLevel(GetLevel(p));
+		p.externallyDriven = false;
+		level = GetLevel(p);
+		if (EdgeTriggers(p, oldLevel))
+			interrupt = StartDelivery(p);
+	}
+
+	if (interrupt)
+		DeliverEdge(pin, *interrupt, level);
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		GetPinLevel
+//
+// Description:		Returns the level of a virtual pin, as seen from outside
+//					the board.  Does not count towards the statistics.
+//
+// Input Arguments:
+//		pin	= const int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for high
+//
+//==========================================================================
+bool SimulatedBoard::GetPinLevel(const int &pin) const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return GetLevel(GetPin(pin));
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		GetDataDirection
+//
+// Description:		Returns the configured data direction of a virtual pin.
+//
+// Input Arguments:
+//		pin	= const int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		GPIO::DataDirection
+//
+//==========================================================================
+GPIO::DataDirection SimulatedBoard::GetDataDirection(const int &pin) const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return GetPin(pin).direction;
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		SetMode
+//
+// Description:		Sets the PWM mode (has no effect on the simulation).
+//
+// Input Arguments:
+//		mode	= const PWMOutput::PWMMode&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SimulatedBoard::SetMode(const PWMOutput::PWMMode &/*mode*/)
+{
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		SetRange
+//
+// Description:		Sets the virtual PWM range.
+//
+// Input Arguments:
+//		range	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SimulatedBoard::SetRange(const unsigned int &range)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	pwmRange = range;
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		SetClockDivisor
+//
+// Description:		Sets the virtual PWM clock divisor.
+//
+// Input Arguments:
+//		divisor	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SimulatedBoard::SetClockDivisor(const unsigned int &divisor)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	pwmDivisor = divisor;
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		Write
+//
+// Description:		Sets the virtual PWM output value.
+//
+// Input Arguments:
+//		pin		= const int&
+//		value	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SimulatedBoard::Write(const int &pin, const unsigned int &value)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	GetPin(pin).pwmValue = value;
+	statistics.pwmWrites++;
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		GetPWMDutyCycle
+//
+// Description:		Returns the duty cycle of a virtual PWM output.
+//
+// Input Arguments:
+//		pin	= const int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		double, 0.0 to 1.0
+//
+//==========================================================================
+double SimulatedBoard::GetPWMDutyCycle(const int &pin) const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (pwmRange == 0)
+		return 0.0;
+	return std::min(1.0, static_cast<double>(GetPin(pin).pwmValue) / pwmRange);
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		GetPWMFrequency
+//
+// Description:		Returns the frequency of the virtual PWM peripheral.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		double [Hz]
+//
+//==========================================================================
+double SimulatedBoard::GetPWMFrequency() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return pwmClockFrequency / pwmDivisor / pwmRange;
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		Open
+//
+// Description:		Opens a virtual I2C bus.  Any device file name is
+//					accepted; each name is a separate bus.
+//
+// Input Arguments:
+//		deviceFileName	= const std::string&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		int, handle for use with other I2C methods
+//
+//==========================================================================
+int SimulatedBoard::Open(const std::string& deviceFileName)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	I2CHandle handle;
+	handle.bus = deviceFileName;
+	handle.open = true;
+	i2cHandles.push_back(handle);
+	return i2cHandles.size() - 1;
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		Close
+//
+// Description:		Closes a virtual I2C bus handle.
+//
+// Input Arguments:
+//		handle	= const int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SimulatedBoard::Close(const int& handle)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	assert(handle >= 0 && handle < static_cast<int>(i2cHandles.size()));
+	i2cHandles[handle].open = false;
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		SelectSlave
+//
+// Description:		Sets the slave address used for subsequent transfers.
+//
+// Input Arguments:
+//		handle	= const int&
+//		address	= const unsigned char&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise (errno is set)
+//
+//==========================================================================
+bool SimulatedBoard::SelectSlave(const int& handle, const unsigned char& address)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (handle < 0 || handle >= static_cast<int>(i2cHandles.size()) || !i2cHandles[handle].open)
+	{
+		errno = EBADF;
+		return false;
+	}
+
+	i2cHandles[handle].address = address;
+	return true;
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		GetI2CDevice
+//
+// Description:		Returns the device selected by a handle.  Sets errno and
+//					returns nullptr if there is no such device.  Caller must
+//					hold the lock.
+//
+// Input Arguments:
+//		handle	= const int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		I2CDevice*
+//
+//==========================================================================
+SimulatedBoard::I2CDevice* SimulatedBoard::GetI2CDevice(const int& handle)
+{
+	if (handle < 0 || handle >= static_cast<int>(i2cHandles.size()) || !i2cHandles[handle].open)
+	{
+		errno = EBADF;
+		return nullptr;
+	}
+
+	const I2CHandle& h(i2cHandles[handle]);
+	auto it(i2cDevices.find(std::make_pair(h.bus, static_cast<unsigned char>(h.address))));
+	if (h.address < 0 || it == i2cDevices.end())
+	{
+		errno = ENXIO;// Same as a real bus with no device acknowledging
+		return nullptr;
+	}
+
+	return it->second.get();
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		Write
+//
+// Description:		Writes to the selected virtual I2C device.
+//
+// Input Arguments:
+//		handle	= const int&
+//		data	= const unsigned char*
+//		size	= const size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		int, number of bytes written, or -1 on failure (errno is set)
+//
+//==========================================================================
+int SimulatedBoard::Write(const int& handle, const unsigned char* data, const size_t& size)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	I2CDevice* device(GetI2CDevice(handle));
+	if (!device)
+		return -1;
+
+	statistics.i2cTransactions++;
+	if (!device->Write(data, size))
+	{
+		errno = EREMOTEIO;
+		return -1;
+	}
+
+	statistics.i2cBytes += size;
+	return size;
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		Read
+//
+// Description:		Reads from the selected virtual I2C device.
+//
+// Input Arguments:
+//		handle	= const int&
+//		size	= const size_t&
+//
+// Output Arguments:
+//		data	= unsigned char*
+//
+// Return Value:
+//		int, number of bytes read, or -1 on failure (errno is set)
+//
+//==========================================================================
+int SimulatedBoard::Read(const int& handle, unsigned char* data, const size_t& size)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	I2CDevice* device(GetI2CDevice(handle));
+	if (!device)
+		return -1;
+
+	statistics.i2cTransactions++;
+	if (!device->Read(data, size))
+	{
+		errno = EREMOTEIO;
+		return -1;
+	}
+
+	statistics.i2cBytes += size;
+	return size;
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		Transfer
+//
+// Description:		Performs a combined transaction on a virtual I2C bus.  The
+//					bus is locked for the whole transaction, and the transaction
+//					stops at the first message that isn't acknowledged.
+//
+// Input Arguments:
+//		handle		= const int&
+//		messages	= Message*
+//		count		= const size_t&
+//
+// Output Arguments:
+//		messages	= Message*, data for read messages is filled in
+//
+// Return Value:
+//		bool, true for success, false otherwise (errno is set)
+//
+//==========================================================================
+bool SimulatedBoard::Transfer(const int& handle, Message* messages, const size_t& count)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (handle < 0 || handle >= static_cast<int>(i2cHandles.size()) || !i2cHandles[handle].open)
+	{
+		errno = EBADF;
+		return false;
+	}
+
+	statistics.i2cTransactions++;
+	size_t i;
+	for (i = 0; i < count; i++)
+	{
+		auto it(i2cDevices.find(std::make_pair(i2cHandles[handle].bus, messages[i].address)));
+		if (it == i2cDevices.end())
+		{
+			errno = ENXIO;
+			return false;
+		}
+
+		if (!(messages[i].read ? it->second->Read(messages[i].data, messages[i].size) :
+			it->second->Write(messages[i].data, messages[i].size)))
+		{
+			errno = EREMOTEIO;
+			return false;
+		}
+
+		statistics.i2cBytes += messages[i].size;
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		AddI2CDevice
+//
+// Description:		Connects a plain register file device to a virtual I2C bus.
+//
+// Input Arguments:
+//		deviceFileName	= const std::string&, identifies the bus
+//		address			= const unsigned char&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		I2CDevice*, owned by the board
+//
+//==========================================================================
+SimulatedBoard::I2CDevice* SimulatedBoard::AddI2CDevice(const std::string& deviceFileName,
+	const unsigned char& address)
+{
+	return AddI2CDevice(deviceFileName, address, std::unique_ptr<I2CDevice>(new I2CDevice));
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		AddI2CDevice
+//
+// Description:		Connects a virtual device to a virtual I2C bus.
+//
+// Input Arguments:
+//		deviceFileName	= const std::string&, identifies the bus
+//		address			= const unsigned char&
+//		device			= std::unique_ptr<I2CDevice>
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		I2CDevice*, owned by the board
+//
+//==========================================================================
+SimulatedBoard::I2CDevice* SimulatedBoard::AddI2CDevice(const std::string& deviceFileName,
+	const unsigned char& address, std::unique_ptr<I2CDevice> device)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	I2CDevice* d(device.get());
+	i2cDevices[std::make_pair(deviceFileName, address)] = std::move(device);
+	return d;
+}
+
+//==========================================================================
+// Class:			SimulatedBoard::I2CDevice
+// Function:		Write
+//
+// Description:		Default device behavior:  the first byte sets the
+//					register pointer and any remaining bytes are written to
+//					consecutive registers.
+//
+// Input Arguments:
+//		data	= const unsigned char*
+//		size	= const size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success (NACK otherwise)
+//
+//==========================================================================
+bool SimulatedBoard::I2CDevice::Write(const unsigned char* data, const size_t& size)
+{
+	if (size == 0)
+		return true;
+
+	registerPointer = data[0];
+	size_t i;
+	for (i = 1; i < size; i++)
+		registers[registerPointer++] = data[i];
+
+	return true;
+}
+
+//==========================================================================
+// Class:			SimulatedBoard::I2CDevice
+// Function:		Read
+//
+// Description:		Default device behavior:  returns consecutive registers
+//					starting from the register pointer.
+//
+// Input Arguments:
+//		size	= const size_t&
+//
+// Output Arguments:
+//		data	= unsigned char*
+//
+// Return Value:
+//		bool, true for success (NACK otherwise)
+//
+//==========================================================================
+bool SimulatedBoard::I2CDevice::Read(unsigned char* data, const size_t& size)
+{
+	size_t i;
+	for (i = 0; i < size; i++)
+		data[i] = registers[registerPointer++];
+
+	return true;
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		AddDS18B20
+//
+// Description:		Adds a virtual DS18B20 to the fake 1-wire device tree.
+//
+// Input Arguments:
+//		deviceID	= const std::string&, e.g. "28-000005e2fdc3"
+//		temperature	= const double& [deg C]
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool SimulatedBoard::AddDS18B20(const std::string& deviceID, const double& temperature)
+{
+	assert(!w1Directory.empty());
+
+	if (mkdir((w1Directory + deviceID).c_str(), 0755) == -1 && errno != EEXIST)
+		return false;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (std::find(ds18b20IDs.begin(), ds18b20IDs.end(), deviceID) == ds18b20IDs.end())
+			ds18b20IDs.push_back(deviceID);
+	}
+
+	{
+		std::ofstream resolution((w1Directory + deviceID + "/resolution").c_str());
+		resolution << "12\n";
+	}
+
+	return WriteW1SlaveFile(deviceID, temperature, true) && UpdateW1MasterSlaveList();
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		SetDS18B20Temperature
+//
+// Description:		Changes the reading reported by a virtual DS18B20.
+//
+// Input Arguments:
+//		deviceID	= const std::string&
+//		temperature	= const double& [deg C]
+//		crcOK		= const bool&, set false to simulate a corrupted reading
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool SimulatedBoard::SetDS18B20Temperature(const std::string& deviceID,
+	const double& temperature, const bool& crcOK)
+{
+	assert(!w1Directory.empty());
+	return WriteW1SlaveFile(deviceID, temperature, crcOK);
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		SetDS18B20ConversionTime
+//
+// Description:		Sets how long bulk conversions take.  Default is 750 ms,
+//					as for a real sensor at 12-bit resolution.
+//
+// Input Arguments:
+//		time	= const std::chrono::milliseconds&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SimulatedBoard::SetDS18B20ConversionTime(const std::chrono::milliseconds& time)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	conversionTime = time;
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		WriteW1SlaveFile
+//
+// Description:		Writes a w1_slave file in the same format as the kernel's
+//					w1-therm driver.
+//
+// Input Arguments:
+//		deviceID	= const std::string&
+//		temperature	= const double& [deg C]
+//		crcOK		= const bool&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool SimulatedBoard::WriteW1SlaveFile(const std::string& deviceID,
+	const double& temperature, const bool& crcOK) const
+{
+	// Scratchpad:  temperature LSB/MSB (1/16 deg C), TH, TL, configuration
+	// (12-bit), three reserved bytes, then CRC
+	const int16_t raw(static_cast<int16_t>(std::lround(temperature * 16.0)));
+	unsigned char scratchpad[9] = {static_cast<unsigned char>(raw & 0xFF),
+		static_cast<unsigned char>((raw >> 8) & 0xFF), 0x4b, 0x46, 0x7f, 0xff, 0x0c, 0x10, 0x00};
+	scratchpad[8] = ComputeCRC8(scratchpad, 8);
+	if (!crcOK)
+		scratchpad[8] ^= 0xFF;
+
+	char bytes[28];
+	unsigned int i;
+	for (i = 0; i < 9; i++)
+		snprintf(bytes + i * 3, 4, "%02x ", scratchpad[i]);
+
+	char crc[3];
+	snprintf(crc, sizeof(crc), "%02x", scratchpad[8]);
+
+	char contents[128];
+	const int length(snprintf(contents, sizeof(contents), "%s: crc=%s %s\n%st=%d\n",
+		bytes, crc, crcOK ? "YES" : "NO", bytes, raw * 625 / 10));
+	if (length < 0 || length >= static_cast<int>(sizeof(contents)))
+		return false;
+
+	// Overwrite in place rather than replacing the file - readers keep the
+	// file open and re-read it, as they would a sysfs attribute
+	const std::string fileName(w1Directory + deviceID + "/w1_slave");
+	const int fileDescriptor(open(fileName.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0644));
+	if (fileDescriptor == -1)
+		return false;
+
+	const bool ok(pwrite(fileDescriptor, contents, length, 0) == length &&
+		ftruncate(fileDescriptor, length) == 0);
+	close(fileDescriptor);
+	return ok;
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		UpdateW1MasterSlaveList
+//
+// Description:		Rewrites the bus master's list of connected devices.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool SimulatedBoard::UpdateW1MasterSlaveList() const
+{
+	std::ofstream file((w1Directory + "w1_bus_master1/w1_master_slaves").c_str(),
+		std::ios::out | std::ios::trunc);
+	if (!file.is_open())
+		return false;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if (ds18b20IDs.empty())
+		file << "not found.\n";
+
+	for (const auto& id : ds18b20IDs)
+		file << id << '\n';
+
+	return file.good();
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		WriteW1BulkReadStatus
+//
+// Description:		Sets the value read from the bus master's therm_bulk_read
+//					attribute.
+//
+// Input Arguments:
+//		status	= const std::string&, "-1", "0" or "1"
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool SimulatedBoard::WriteW1BulkReadStatus(const std::string& status) const
+{
+	// In place, like WriteW1SlaveFile, since DS18B20Bus keeps the file open
+	const std::string contents(status + "\n");
+	const int fileDescriptor(open((w1Directory + "w1_bus_master1/therm_bulk_read").c_str(),
+		O_WRONLY | O_CREAT | O_CLOEXEC, 0644));
+	if (fileDescriptor == -1)
+		return false;
+
+	const ssize_t length(contents.length());
+	const bool ok(pwrite(fileDescriptor, contents.c_str(), length, 0) == length &&
+		ftruncate(fileDescriptor, length) == 0);
+	close(fileDescriptor);
+	return ok;
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		W1ThreadEntry
+//
+// Description:		Emulates the kernel's handling of the therm_bulk_read
+//					attribute.  Every change to the file is checked for a
+//					trigger command (our own status updates are changes,
+//					too, and are ignored).  After a trigger, the attribute
+//					reads -1 until the conversion time has elapsed, and 1
+//					after that.
+//
+// Input Arguments:
+//		inotifyFileDescriptor	= const int, watching therm_bulk_read; closed
+//								  on return
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SimulatedBoard::W1ThreadEntry(const int inotifyFileDescriptor)
+{
+	const std::string fileName(w1Directory + "w1_bus_master1/therm_bulk_read");
+	bool converting(false);
+	std::chrono::steady_clock::time_point conversionEnd;
+
+	while (true)
+	{
+		int timeout(-1);
+		if (converting)
+			timeout = std::max(static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+				conversionEnd - std::chrono::steady_clock::now()).count()) + 1, 0);
+
+		pollfd fileDescriptors[2];
+		fileDescriptors[0].fd = inotifyFileDescriptor;
+		fileDescriptors[0].events = POLLIN;
+		fileDescriptors[1].fd = w1StopFileDescriptor;
+		fileDescriptors[1].events = POLLIN;
+		if (poll(fileDescriptors, 2, timeout) == -1 && errno != EINTR)
+			break;
+
+		if (fileDescriptors[1].revents & POLLIN)
+			break;
+
+		if (fileDescriptors[0].revents & POLLIN)
+		{
+			// We only watch one file, so the contents of the events don't matter
+			char events[4096];
+			if (read(inotifyFileDescriptor, events, sizeof(events)) == -1 && errno != EINTR)
+				break;
+
+			std::string command;
+			{
+				std::ifstream file(fileName.c_str());
+				file >> command;
+			}
+
+			if (command == "trigger")
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				conversionEnd = std::chrono::steady_clock::now() + conversionTime;
+				converting = true;
+				WriteW1BulkReadStatus("-1");
+			}
+		}
+
+		if (converting && std::chrono::steady_clock::now() >= conversionEnd)
+		{
+			converting = false;
+			WriteW1BulkReadStatus("1");
+		}
+	}
+
+	close(inotifyFileDescriptor);
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		ComputeCRC8
+//
+// Description:		Computes the Dallas/Maxim 1-wire CRC.
+//
+// Input Arguments:
+//		data	= const unsigned char*
+//		size	= const size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		unsigned char
+//
+//==========================================================================
+unsigned char SimulatedBoard::ComputeCRC8(const unsigned char* data, const size_t& size)
+{
+	unsigned char crc(0);
+	size_t i;
+	for (i = 0; i < size; i++)
+	{
+		unsigned char byte(data[i]);
+		unsigned int bit;
+		for (bit = 0; bit < 8; bit++)
+		{
+			const bool mix((crc ^ byte) & 0x01);
+			crc >>= 1;
+			if (mix)
+				crc ^= 0x8C;
+			byte >>= 1;
+		}
+	}
+
+	return crc;
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		GetStatistics
+//
+// Description:		Returns counts of hardware accesses since construction
+//					or the last call to ResetStatistics.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Statistics
+//
+//==========================================================================
+SimulatedBoard::Statistics SimulatedBoard::GetStatistics() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return statistics;
+}
+
+//==========================================================================
+// Class:			SimulatedBoard
+// Function:		ResetStatistics
+//
+// Description:		Clears the hardware access counters.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SimulatedBoard::ResetStatistics()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	statistics = Statistics();
+}
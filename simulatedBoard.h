@@ -0,0 +1,176 @@
+// File:  simulatedBoard.h
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  Software model of a Raspberry Pi, for running and benchmarking code
+//        that uses the classes in this repository on machines without the
+//        real hardware.  Provides virtual GPIO pins (with interrupts), a
+//        virtual PWM peripheral, virtual I2C buses and a fake 1-wire sysfs
+//        tree that the DS18B20 class can read.
+
+#ifndef SIMULATED_BOARD_H_
+#define SIMULATED_BOARD_H_
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+
+// Local headers
+#include "gpioBackend.h"
+#include "pwmBackend.h"
+#include "i2cBackend.h"
+
+class SimulatedBoard : public GPIOBackend, public PWMBackend, public I2CBackend
+{
+public:
+	// If w1Directory is not empty, a fake 1-wire device tree is created there
+	SimulatedBoard(const std::string& w1Directory = std::string());
+	~SimulatedBoard();
+
+	// Makes this board the default backend for GPIO, PWMOutput and TWI objects
+	void MakeDefault();
+
+	// GPIOBackend methods
+	virtual void SetDataDirection(const int &pin, const GPIO::DataDirection &direction);
+	virtual void SetPullUpDown(const int &pin, const GPIO::PullResistance &state);
+	virtual void SetOutput(const int &pin, const bool &high);
+	virtual bool GetInput(const int &pin);
+	virtual void SetOutputs(const std::vector<int> &pins, const uint32_t &values, const uint32_t &mask);
+	virtual uint32_t GetInputs(const std::vector<int> &pins);
+	virtual bool AttachInterrupt(Interrupt &interrupt, const Interrupt::EdgeDirection &edge);
+	virtual void DetachInterrupt(Interrupt &interrupt);
+
+	// PWMBackend methods
+	virtual void SetMode(const PWMOutput::PWMMode &mode);
+	virtual void SetRange(const unsigned int &range);
+	virtual void SetClockDivisor(const unsigned int &divisor);
+	virtual void Write(const int &pin, const unsigned int &value);
+
+	// I2CBackend methods
+	virtual int Open(const std::string& deviceFileName);
+	virtual void Close(const int& handle);
+	virtual bool SelectSlave(const int& handle, const unsigned char& address);
+	virtual int Write(const int& handle, const unsigned char* data, const size_t& size);
+	virtual int Read(const int& handle, unsigned char* data, const size_t& size);
+	virtual bool Transfer(const int& handle, Message* messages, const size_t& count);
+
+	// Drives a pin from "outside" the board; interrupts attached to the pin
+	// are called from the calling thread
+	void DriveInput(const int &pin, const bool &high);
+	void ReleaseInput(const int &pin);// Pin returns to the level set by its pull resistor
+	bool GetPinLevel(const int &pin) const;
+	GPIO::DataDirection GetDataDirection(const int &pin) const;
+
+	double GetPWMDutyCycle(const int &pin) const;
+	double GetPWMFrequency() const;// [Hz]
+
+	// Default I2C device behavior is a 256-byte register file with an
+	// auto-incrementing register pointer set by the first byte of each write
+	class I2CDevice
+	{
+	public:
+		virtual ~I2CDevice() {}
+		virtual bool Write(const unsigned char* data, const size_t& size);
+		virtual bool Read(unsigned char* data, const size_t& size);
+
+		unsigned char registers[256] = {};
+
+	protected:
+		unsigned char registerPointer = 0;
+	};
+
+	// Returns a pointer owned by the board
+	I2CDevice* AddI2CDevice(const std::string& deviceFileName, const unsigned char& address);
+	I2CDevice* AddI2CDevice(const std::string& deviceFileName, const unsigned char& address,
+		std::unique_ptr<I2CDevice> device);
+
+	std::string GetW1DeviceDirectory() const { return w1Directory; }
+	bool AddDS18B20(const std::string& deviceID, const double& temperature);// [deg C]
+	bool SetDS18B20Temperature(const std::string& deviceID, const double& temperature,
+		const bool& crcOK = true);// [deg C]
+
+	// Writing "trigger" to the bus master's therm_bulk_read attribute starts
+	// a bulk conversion:  the attribute then reads -1 for this long, and 1
+	// afterwards (0 until the first trigger)
+	void SetDS18B20ConversionTime(const std::chrono::milliseconds& time);
+
+	struct Statistics
+	{
+		uint64_t pinWrites = 0;
+		uint64_t pinReads = 0;
+		uint64_t interruptsDelivered = 0;
+		uint64_t pwmWrites = 0;
+		uint64_t i2cTransactions = 0;
+		uint64_t i2cBytes = 0;
+	};
+
+	Statistics GetStatistics() const;
+	void ResetStatistics();
+
+private:
+	static const unsigned int pinCount;
+	static const double pwmClockFrequency;// [Hz]
+
+	struct Pin
+	{
+		GPIO::DataDirection direction = GPIO::DataDirection::Input;
+		GPIO::PullResistance pull = GPIO::PullResistance::Off;
+		bool outputLevel = false;
+		bool externallyDriven = false;
+		bool externalLevel = false;
+		unsigned int pwmValue = 0;
+		Interrupt *interrupt = nullptr;
+		Interrupt::EdgeDirection edge = Interrupt::EdgeDirection::Rising;
+		unsigned int deliveries = 0;// Service routine calls in progress
+	};
+
+	struct I2CHandle
+	{
+		std::string bus;
+		int address = -1;
+		bool open = false;
+	};
+
+	mutable std::mutex mutex;
+	std::vector<Pin> pins;
+	std::condition_variable deliveryComplete;
+	static thread_local Interrupt *deliveringInterrupt;// nullptr unless this thread is in a service routine
+
+	unsigned int pwmRange = 1024;
+	unsigned int pwmDivisor = 2;
+
+	std::vector<I2CHandle> i2cHandles;
+	std::map<std::pair<std::string, unsigned char>, std::unique_ptr<I2CDevice>> i2cDevices;
+
+	const std::string w1Directory;
+	std::vector<std::string> ds18b20IDs;
+	std::chrono::milliseconds conversionTime;
+
+	std::thread w1Thread;
+	int w1StopFileDescriptor;
+
+	Statistics statistics;
+
+	Pin& GetPin(const int &pin);
+	const Pin& GetPin(const int &pin) const;
+	static bool GetLevel(const Pin &pin);
+	static bool EdgeTriggers(const Pin &pin, const bool &oldLevel);
+	Interrupt* StartDelivery(Pin &pin);
+	void DeliverEdge(const int &pin, Interrupt &interrupt, const bool &rising);
+	I2CDevice* GetI2CDevice(const int& handle);
+
+	bool WriteW1SlaveFile(const std::string& deviceID, const double& temperature, const bool& crcOK) const;
+	bool UpdateW1MasterSlaveList() const;
+	bool WriteW1BulkReadStatus(const std::string& status) const;
+	void W1ThreadEntry(const int inotifyFileDescriptor);
+	static unsigned char ComputeCRC8(const unsigned char* data, const size_t& size);
+};
+
+#endif// SIMULATED_BOARD_H_
@@ -0,0 +1,611 @@
+// File:  softwarePWM.cpp
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  Software PWM on any number of ordinary GPIO pins (up to 32), each
+//        with its own frequency and duty cycle, driven by one timer thread.
+//        Edges that are due at (nearly) the same time are written together
+//        with a single bank write.  Suitable for LEDs, fans and the like -
+//        use PWMOutput where hardware PWM is available and timing matters.
+
+// Standard C/C++ headers
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+
+// *nix standard headers
+#include <unistd.h>
+#include <poll.h>
+#include <sys/timerfd.h>
+#include <sys/eventfd.h>
+
+// Local headers
+#include "softwarePWM.h"
+
+//==========================================================================
+// Class:			SoftwarePWM
+// Function:		SoftwarePWM
+//
+// Description:		Constructor for SoftwarePWM class.
+//
+// Input Arguments:
+//		backend			= GPIOBackend&
+//		coalesceWindow	= const std::chrono::nanoseconds&
+//		outStream		= std::ostream&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+SoftwarePWM::SoftwarePWM(GPIOBackend &backend, const std::chrono::nanoseconds &coalesceWindow,
+	std::ostream &outStream) : backend(backend),
+	coalesceWindow(std::chrono::duration_cast<Clock::duration>(coalesceWindow)),
+	outStream(outStream), stopTimerThread(false), transactionPending(false)
+{
+	// steady_clock and CLOCK_MONOTONIC share an epoch on Linux
+	timerFileDescriptor = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+	wakeFileDescriptor = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (timerFileDescriptor == -1 || wakeFileDescriptor == -1)
+		outStream << "Failed to create timer descriptors:  " << strerror(errno) << std::endl;
+}
+
+//==========================================================================
+// Class:			SoftwarePWM
+// Function:		~SoftwarePWM
+//
+// Description:		Destructor for SoftwarePWM class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+SoftwarePWM::~SoftwarePWM()
+{
+	Stop();
+
+	if (timerFileDescriptor != -1)
+		close(timerFileDescriptor);
+	if (wakeFileDescriptor != -1)
+		close(wakeFileDescriptor);
+}
+
+//==========================================================================
+// Class:			SoftwarePWM
+// Function:		AddChannel
+//
+// Description:		Adds a PWM channel on the specified pin.
+//
+// Input Arguments:
+//		pin			= const int&
+//		frequency	= const double& [Hz]
+//		duty		= const double&, 0.0 to 1.0
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		unsigned int, index of the new channel
+//
+//==========================================================================
+unsigned int SoftwarePWM::AddChannel(const int &pin, const double &frequency, const double &duty)
+{
+	assert(!timerThread.joinable());
+	assert(channels.size() < 32);
+	assert(duty >= 0.0 && duty <= 1.0);
+
+	std::unique_ptr<Channel> channel(new Channel);
+	channel->pin = pin;
+	channel->period = ComputePeriod(frequency);
+	channel->duty = duty;
+	channel->high = false;
+	channel->nextIsPeriodStart = true;
+	channels.push_back(std::move(channel));
+
+	return channels.size() - 1;
+}
+
+//==========================================================================
+// Class:			SoftwarePWM
+// Function:		SetDutyCycle
+//
+// Description:		Sets the duty cycle for the specified channel.
+//
+// Input Arguments:
+//		channel	= const unsigned int&
+//		duty	= const double&, 0.0 to 1.0
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SoftwarePWM::SetDutyCycle(const unsigned int &channel, const double &duty)
+{
+	assert(channel < channels.size());
+	assert(duty >= 0.0 && duty <= 1.0);
+	channels[channel]->duty = duty;
+}
+
+//==========================================================================
+// Class:			SoftwarePWM
+// Function:		SetFrequency
+//
+// Description:		Sets the frequency for the specified channel.
+//
+// Input Arguments:
+//		channel		= const unsigned int&
+//		frequency	= const double& [Hz]
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SoftwarePWM::SetFrequency(const unsigned int &channel, const double &frequency)
+{
+	assert(channel < channels.size());
+	channels[channel]->period = ComputePeriod(frequency);
+}
+
+//==========================================================================
+// Class:			SoftwarePWM
+// Function:		Commit
+//
+// Description:		Stages new values for a group of channels, to be applied
+//					together by the timer thread (or immediately if it isn't
+//					running).
+//
+// Input Arguments:
+//		updates	= const std::vector<ChannelUpdate>&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SoftwarePWM::Commit(const std::vector<ChannelUpdate> &updates)
+{
+	for (const auto& update : updates)
+	{
+		assert(update.channel < channels.size());
+		assert(update.duty >= 0.0 && update.duty <= 1.0);
+	}
+
+	if (!timerThread.joinable())
+	{
+		for (const auto& update : updates)
+		{
+			channels[update.channel]->duty = update.duty;
+			if (update.frequency > 0.0)
+				channels[update.channel]->period = ComputePeriod(update.frequency);
+		}
+		return;
+	}
+
+	// The timer thread applies the pending updates under this lock too, so
+	// the channel values can't change while we compare against them
+	std::lock_guard<std::mutex> lock(transactionMutex);
+	for (const auto& update : updates)
+	{
+		// An update that hasn't been applied yet is replaced, so the most
+		// recent values for each channel win
+		ChannelUpdate merged(update);
+		auto pending(std::find_if(pendingUpdates.begin(), pendingUpdates.end(),
+			[&update](const ChannelUpdate& u)
+		{
+			return u.channel == update.channel;
+		}));
+
+		if (pending != pendingUpdates.end())
+		{
+			if (merged.frequency <= 0.0)
+				merged.frequency = pending->frequency;
+			pendingUpdates.erase(pending);
+		}
+
+		const Channel& channel(*channels[merged.channel]);
+		if (merged.duty == channel.duty &&
+			(merged.frequency <= 0.0 || ComputePeriod(merged.frequency) == channel.period))
+			continue;// Channel is already running with these values
+
+		pendingUpdates.push_back(merged);
+	}
+
+	transactionPending = !pendingUpdates.empty();
+}
+
+//==========================================================================
+// Class:			SoftwarePWM
+// Function:		Start
+//
+// Description:		Configures the pins and starts the timer thread.  All
+//					channels begin their first period together.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool SoftwarePWM::Start()
+{
+	if (timerThread.joinable() || channels.empty() ||
+		timerFileDescriptor == -1 || wakeFileDescriptor == -1)
+		return false;
+
+	std::vector<int> pins;
+	for (const auto& channel : channels)
+		pins.push_back(channel->pin);
+	bank.reset(new GPIOBank(pins, GPIO::DataDirection::Output, backend));
+	bank->SetOutputs(0);
+
+	const Clock::time_point startTime(Clock::now());
+	for (auto& channel : channels)
+	{
+		channel->high = false;
+		channel->nextEventTime = startTime;
+		channel->nextIsPeriodStart = true;
+	}
+
+	uint64_t wake;
+	if (read(wakeFileDescriptor, &wake, sizeof(wake)) == -1 && errno != EAGAIN)
+		outStream << "Failed to clear wake descriptor:  " << strerror(errno) << std::endl;
+
+	stopTimerThread = false;
+	timerThread = std::thread(&SoftwarePWM::TimerThreadEntry, this);
+	return true;
+}
+
+//==========================================================================
+// Class:			SoftwarePWM
+// Function:		Stop
+//
+// Description:		Stops the timer thread and drives all pins low.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SoftwarePWM::Stop()
+{
+	if (!timerThread.joinable())
+		return;
+
+	stopTimerThread = true;
+	const uint64_t wake(1);
+	if (write(wakeFileDescriptor, &wake, sizeof(wake)) != sizeof(wake))
+		outStream << "Failed to wake timer thread:  " << strerror(errno) << std::endl;
+	timerThread.join();
+
+	bank.reset();
+}
+
+//==========================================================================
+// Class:			SoftwarePWM
+// Function:		GetStatistics
+//
+// Description:		Returns a copy of the timing statistics.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Statistics
+//
+//==========================================================================
+SoftwarePWM::Statistics SoftwarePWM::GetStatistics() const
+{
+	std::lock_guard<std::mutex> lock(statisticsMutex);
+	return statistics;
+}
+
+//==========================================================================
+// Class:			SoftwarePWM
+// Function:		ResetStatistics
+//
+// Description:		Clears the timing statistics.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SoftwarePWM::ResetStatistics()
+{
+	std::lock_guard<std::mutex> lock(statisticsMutex);
+	statistics = Statistics();
+}
+
+//==========================================================================
+// Class:			SoftwarePWM
+// Function:		TimerThreadEntry
+//
+// Description:		Entry point for the timer thread.  Sleeps until the next
+//					edge is due, then writes every edge due within the
+//					coalescing window at once.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SoftwarePWM::TimerThreadEntry()
+{
+	while (!stopTimerThread)
+	{
+		Clock::time_point nextEventTime(Clock::time_point::max());
+		for (const auto& channel : channels)
+			nextEventTime = std::min(nextEventTime, channel->nextEventTime);
+
+		if (!WaitUntil(nextEventTime))
+			return;
+
+		if (transactionPending)
+			ApplyTransaction();
+
+		const Clock::time_point now(Clock::now());
+		uint32_t values(0), mask(0);
+		unsigned int edgeCount(0);
+		Clock::duration totalLateness(Clock::duration::zero());
+		Clock::duration maxLateness(Clock::duration::zero());
+
+		unsigned int i;
+		for (i = 0; i < channels.size(); i++)
+		{
+			Channel& channel(*channels[i]);
+
+			// At most one event per channel per pass, so that pulses shorter
+			// than the coalescing window are not lost
+			if (channel.nextEventTime > now + coalesceWindow)
+				continue;
+
+			const Clock::duration lateness(std::max(now - channel.nextEventTime, Clock::duration::zero()));
+			const bool wasHigh(channel.high);
+			ProcessEvent(channel, now);
+			if (channel.high == wasHigh)
+				continue;
+
+			mask |= 1u << i;
+			if (channel.high)
+				values |= 1u << i;
+
+			edgeCount++;
+			totalLateness += lateness;
+			maxLateness = std::max(maxLateness, lateness);
+		}
+
+		if (mask == 0)
+			continue;
+
+		bank->SetOutputs(values, mask);
+
+		std::lock_guard<std::mutex> lock(statisticsMutex);
+		statistics.edgeCount += edgeCount;
+		statistics.writeCount++;
+		statistics.totalLateness += totalLateness;
+		statistics.maxLateness = std::max(statistics.maxLateness, maxLateness);
+	}
+}
+
+//==========================================================================
+// Class:			SoftwarePWM
+// Function:		ApplyTransaction
+//
+// Description:		Moves the next period start of every channel in the
+//					pending transaction to the earliest of them, and sets the
+//					values those periods will use.  A channel whose on-time
+//					would run past that point is cut short.  Called only by
+//					the timer thread, before it processes any events, so no
+//					period of these channels can begin before this returns.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SoftwarePWM::ApplyTransaction()
+{
+	std::lock_guard<std::mutex> lock(transactionMutex);
+	std::vector<ChannelUpdate> updates;
+	updates.swap(pendingUpdates);
+	transactionPending = false;
+
+	Clock::time_point boundary(Clock::time_point::max());
+	for (const auto& update : updates)
+	{
+		const Channel& channel(*channels[update.channel]);
+		boundary = std::min(boundary, channel.nextIsPeriodStart ? channel.nextEventTime : channel.nextPeriodStart);
+	}
+
+	for (const auto& update : updates)
+	{
+		Channel& channel(*channels[update.channel]);
+		channel.duty = update.duty;
+		if (update.frequency > 0.0)
+			channel.period = ComputePeriod(update.frequency);
+
+		if (!channel.nextIsPeriodStart && channel.nextEventTime < boundary)
+			channel.nextPeriodStart = boundary;
+		else
+		{
+			channel.nextEventTime = boundary;
+			channel.nextIsPeriodStart = true;
+		}
+	}
+}
+
+//==========================================================================
+// Class:			SoftwarePWM
+// Function:		WaitUntil
+//
+// Description:		Sleeps until the specified time, or until Stop is called.
+//
+// Input Arguments:
+//		time	= const Clock::time_point&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if the time was reached, false if stopping (or on error)
+//
+//==========================================================================
+bool SoftwarePWM::WaitUntil(const Clock::time_point &time)
+{
+	const std::chrono::nanoseconds sinceEpoch(time.time_since_epoch());
+	itimerspec timerSpec;
+	memset(&timerSpec, 0, sizeof(timerSpec));
+	timerSpec.it_value.tv_sec = sinceEpoch.count() / 1000000000LL;
+	timerSpec.it_value.tv_nsec = sinceEpoch.count() % 1000000000LL;
+	if (timerfd_settime(timerFileDescriptor, TFD_TIMER_ABSTIME, &timerSpec, nullptr) == -1)
+	{
+		outStream << "Failed to set PWM timer:  " << strerror(errno) << std::endl;
+		return false;
+	}
+
+	pollfd descriptors[2];
+	descriptors[0].fd = timerFileDescriptor;
+	descriptors[0].events = POLLIN;
+	descriptors[1].fd = wakeFileDescriptor;
+	descriptors[1].events = POLLIN;
+
+	while (!stopTimerThread)
+	{
+		if (poll(descriptors, 2, -1) == -1)
+		{
+			if (errno == EINTR)
+				continue;
+
+			outStream << "Failed to wait for PWM timer:  " << strerror(errno) << std::endl;
+			return false;
+		}
+
+		if (descriptors[0].revents & POLLIN)
+		{
+			uint64_t expirations;
+			if (read(timerFileDescriptor, &expirations, sizeof(expirations)) == -1 && errno != EAGAIN)
+				outStream << "Failed to read PWM timer:  " << strerror(errno) << std::endl;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//==========================================================================
+// Class:			SoftwarePWM
+// Function:		ProcessEvent
+//
+// Description:		Applies the channel's next edge and schedules the one
+//					after it.  Frequency and duty cycle changes are picked up
+//					at the start of each period.
+//
+// Input Arguments:
+//		channel	= Channel&
+//		now		= const Clock::time_point&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void SoftwarePWM::ProcessEvent(Channel &channel, const Clock::time_point &now)
+{
+	if (!channel.nextIsPeriodStart)
+	{
+		channel.high = false;
+		channel.nextEventTime = channel.nextPeriodStart;
+		channel.nextIsPeriodStart = true;
+		return;
+	}
+
+	const Clock::duration period(channel.period.load());
+	Clock::time_point periodStart(channel.nextEventTime);
+
+	// If we've fallen more than a period behind (e.g. the thread was not
+	// scheduled), start over from now instead of trying to catch up
+	if (periodStart + period < now)
+		periodStart = now;
+
+	const Clock::duration onTime(std::chrono::duration_cast<Clock::duration>(period * channel.duty.load()));
+	channel.nextPeriodStart = periodStart + period;
+	if (onTime <= Clock::duration::zero() || onTime >= period)
+	{
+		channel.high = onTime > Clock::duration::zero();
+		channel.nextEventTime = channel.nextPeriodStart;
+	}
+	else
+	{
+		channel.high = true;
+		channel.nextEventTime = periodStart + onTime;
+		channel.nextIsPeriodStart = false;
+	}
+}
+
+//==========================================================================
+// Class:			SoftwarePWM
+// Function:		ComputePeriod
+//
+// Description:		Converts frequency to period.
+//
+// Input Arguments:
+//		frequency	= const double& [Hz]
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Clock::rep
+//
+//==========================================================================
+SoftwarePWM::Clock::rep SoftwarePWM::ComputePeriod(const double &frequency)
+{
+	assert(frequency > 0.0);
+	return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / frequency)).count();
+}
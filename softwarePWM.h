@@ -0,0 +1,116 @@
+// File:  softwarePWM.h
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  Software PWM on any number of ordinary GPIO pins (up to 32), each
+//        with its own frequency and duty cycle, driven by one timer thread.
+//        Edges that are due at (nearly) the same time are written together
+//        with a single bank write.  Suitable for LEDs, fans and the like -
+//        use PWMOutput where hardware PWM is available and timing matters.
+
+#ifndef SOFTWARE_PWM_H_
+#define SOFTWARE_PWM_H_
+
+// Standard C++ headers
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <iostream>
+#include <cstdint>
+
+// Local headers
+#include "gpioBank.h"
+
+class SoftwarePWM
+{
+public:
+	// Edges due within coalesceWindow of each other are written together
+	SoftwarePWM(GPIOBackend &backend = GPIO::GetDefaultBackend(),
+		const std::chrono::nanoseconds &coalesceWindow = std::chrono::microseconds(10),
+		std::ostream &outStream = std::cout);
+	~SoftwarePWM();
+
+	// Returns the channel index.  Add all channels before calling Start.
+	unsigned int AddChannel(const int &pin, const double &frequency, const double &duty = 0.0);
+
+	// Changes take effect at the start of the channel's next period
+	void SetDutyCycle(const unsigned int &channel, const double &duty);// 0.0 to 1.0
+	void SetFrequency(const unsigned int &channel, const double &frequency);// [Hz]
+
+	// Changes several channels together:  at the next period start of any of
+	// the listed channels, all of them begin a new period with their new
+	// values.  Updates that wouldn't change anything are skipped.  A channel
+	// committed again before its earlier update is applied gets only the
+	// latest values.
+	struct ChannelUpdate
+	{
+		unsigned int channel;
+		double duty;// 0.0 to 1.0
+		double frequency;// [Hz], zero to leave unchanged
+	};
+
+	void Commit(const std::vector<ChannelUpdate> &updates);
+
+	bool Start();
+	void Stop();
+
+	typedef std::chrono::steady_clock Clock;
+
+	// Lateness is the time from when an edge was due to when it was written
+	struct Statistics
+	{
+		uint64_t edgeCount = 0;
+		uint64_t writeCount = 0;// Bank writes (each may contain several edges)
+		Clock::duration totalLateness = Clock::duration::zero();
+		Clock::duration maxLateness = Clock::duration::zero();
+	};
+
+	Statistics GetStatistics() const;
+	void ResetStatistics();
+
+private:
+	GPIOBackend &backend;
+	const Clock::duration coalesceWindow;
+	std::ostream &outStream;
+
+	struct Channel
+	{
+		int pin;
+
+		// Written by the caller, read by the timer thread at each period start
+		std::atomic<Clock::rep> period;
+		std::atomic<double> duty;
+
+		// Timer thread only
+		bool high;
+		Clock::time_point nextEventTime;
+		Clock::time_point nextPeriodStart;
+		bool nextIsPeriodStart;
+	};
+
+	std::vector<std::unique_ptr<Channel>> channels;
+	std::unique_ptr<GPIOBank> bank;
+
+	std::thread timerThread;
+	int timerFileDescriptor;
+	int wakeFileDescriptor;
+	std::atomic<bool> stopTimerThread;
+
+	mutable std::mutex statisticsMutex;
+	Statistics statistics;
+
+	std::mutex transactionMutex;
+	std::vector<ChannelUpdate> pendingUpdates;
+	std::atomic<bool> transactionPending;
+
+	void TimerThreadEntry();
+	void ApplyTransaction();
+	bool WaitUntil(const Clock::time_point &time);
+	static void ProcessEvent(Channel &channel, const Clock::time_point &now);
+	static Clock::rep ComputePeriod(const double &frequency);
+};
+
+#endif// SOFTWARE_PWM_H_
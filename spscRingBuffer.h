@@ -0,0 +1,205 @@
+// File:  spscRingBuffer.h
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  Fixed-capacity, lock-free ring buffer for passing items from exactly
+//        one producer thread to exactly one consumer thread.  All storage is
+//        allocated at construction.
+
+#ifndef SPSC_RING_BUFFER_H_
+#define SPSC_RING_BUFFER_H_
+
+// Standard C++ headers
+#include <vector>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+
+template <typename T>
+class SPSCRingBuffer
+{
+public:
+	explicit SPSCRingBuffer(const size_t &minimumCapacity);
+
+	// Producer side
+	bool Push(const T &item);
+
+	// Consumer side
+	bool Pop(T &item);
+	size_t Pop(T *items, const size_t &maxItems);
+
+	size_t GetSize() const;
+	size_t GetCapacity() const { return buffer.size(); }
+
+private:
+	static size_t RoundUpToPowerOfTwo(const size_t &value);
+
+	std::vector<T> buffer;
+	const size_t indexMask;
+
+	// Indices increase without bound and are masked on use; keeping them on
+	// separate cache lines avoids false sharing between the two threads
+	alignas(64) std::atomic<size_t> writeIndex;
+	alignas(64) std::atomic<size_t> readIndex;
+};
+
+//==========================================================================
+// Class:			SPSCRingBuffer
+// Function:		SPSCRingBuffer
+//
+// Description:		Constructor for SPSCRingBuffer class.
+//
+// Input Arguments:
+//		minimumCapacity	= const size_t&, rounded up to a power of two
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+template <typename T>
+SPSCRingBuffer<T>::SPSCRingBuffer(const size_t &minimumCapacity)
+	: buffer(RoundUpToPowerOfTwo(minimumCapacity)), indexMask(buffer.size() - 1),
+	writeIndex(0), readIndex(0)
+{
+}
+
+//==========================================================================
+// Class:			SPSCRingBuffer
+// Function:		Push
+//
+// Description:		Adds an item to the buffer.  Call only from the producer.
+//
+// Input Arguments:
+//		item	= const T&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false if the buffer is full
+//
+//==========================================================================
+template <typename T>
+bool SPSCRingBuffer<T>::Push(const T &item)
+{
+	const size_t write(writeIndex.load(std::memory_order_relaxed));
+	if (write - readIndex.load(std::memory_order_acquire) >= buffer.size())
+		return false;
+
+	buffer[write & indexMask] = item;
+	writeIndex.store(write + 1, std::memory_order_release);
+	return true;
+}
+
+//==========================================================================
+// Class:			SPSCRingBuffer
+// Function:		Pop
+//
+// Description:		Removes one item from the buffer.  Call only from the
+//					consumer.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		item	= T&
+//
+// Return Value:
+//		bool, true for success, false if the buffer is empty
+//
+//==========================================================================
+template <typename T>
+bool SPSCRingBuffer<T>::Pop(T &item)
+{
+	return Pop(&item, 1) == 1;
+}
+
+//==========================================================================
+// Class:			SPSCRingBuffer
+// Function:		Pop
+//
+// Description:		Removes up to maxItems items from the buffer in one
+//					batch.  Call only from the consumer.
+//
+// Input Arguments:
+//		maxItems	= const size_t&
+//
+// Output Arguments:
+//		items		= T*, must have room for maxItems items
+//
+// Return Value:
+//		size_t, number of items removed
+//
+//==========================================================================
+template <typename T>
+size_t SPSCRingBuffer<T>::Pop(T *items, const size_t &maxItems)
+{
+	const size_t read(readIndex.load(std::memory_order_relaxed));
+	const size_t available(writeIndex.load(std::memory_order_acquire) - read);
+	const size_t count(available < maxItems ? available : maxItems);
+
+	size_t i;
+	for (i = 0; i < count; i++)
+		items[i] = buffer[(read + i) & indexMask];
+
+	readIndex.store(read + count, std::memory_order_release);
+	return count;
+}
+
+//==========================================================================
+// Class:			SPSCRingBuffer
+// Function:		GetSize
+//
+// Description:		Returns the number of items in the buffer.  The value may
+//					be out of date by the time it is used.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		size_t
+//
+//==========================================================================
+template <typename T>
+size_t SPSCRingBuffer<T>::GetSize() const
+{
+	// Read index first so the difference can never be negative
+	const size_t read(readIndex.load(std::memory_order_acquire));
+	return writeIndex.load(std::memory_order_acquire) - read;
+}
+
+//==========================================================================
+// Class:			SPSCRingBuffer
+// Function:		RoundUpToPowerOfTwo
+//
+// Description:		Returns the smallest power of two not less than value.
+//
+// Input Arguments:
+//		value	= const size_t&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		size_t
+//
+//==========================================================================
+template <typename T>
+size_t SPSCRingBuffer<T>::RoundUpToPowerOfTwo(const size_t &value)
+{
+	assert(value > 0);
+
+	size_t capacity(1);
+	while (capacity < value)
+		capacity <<= 1;
+
+	return capacity;
+}
+
+#endif// SPSC_RING_BUFFER_H_
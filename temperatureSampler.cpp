@@ -0,0 +1,371 @@
+// File:  temperatureSampler.cpp
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  Reads a set of temperature sensors on worker threads, each at its own
+//        rate, and keeps the most recent reading from each so that control
+//        loops can get a temperature without waiting for a conversion.
+
+// Standard C++ headers
+#include <cassert>
+
+// Local headers
+#include "temperatureSampler.h"
+
+//==========================================================================
+// Class:			TemperatureSampler
+// Function:		TemperatureSampler
+//
+// Description:		Constructor for TemperatureSampler class.
+//
+// Input Arguments:
+//		threadCount	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+TemperatureSampler::TemperatureSampler(const unsigned int& threadCount)
+	: threadCount(threadCount), stopThreads(false)
+{
+	assert(threadCount > 0);
+}
+
+//==========================================================================
+// Class:			TemperatureSampler
+// Function:		~TemperatureSampler
+//
+// Description:		Destructor for TemperatureSampler class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+TemperatureSampler::~TemperatureSampler()
+{
+	Stop();
+}
+
+//==========================================================================
+// Class:			TemperatureSampler
+// Function:		AddSensor
+//
+// Description:		Adds a sensor to be read at the specified period.
+//
+// Input Arguments:
+//		sensor	= std::unique_ptr<TemperatureSensor>
+//		period	= const std::chrono::milliseconds&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		unsigned int, index of the new sensor
+//
+//==========================================================================
+unsigned int TemperatureSampler::AddSensor(std::unique_ptr<TemperatureSensor> sensor,
+	const std::chrono::milliseconds& period)
+{
+	assert(sensor);
+	assert(workerThreads.empty());
+
+	std::unique_ptr<Entry> entry(new Entry);
+	entry->sensor = std::move(sensor);
+	entry->period = period;
+	entry->nextDue = period > std::chrono::milliseconds::zero() ? Clock::time_point::min() : Clock::time_point::max();
+	entry->busy = false;
+	entry->sequence = 0;
+	entry->valid = false;
+	entry->temperature = 0.0;
+	entry->time = 0;
+
+	entries.push_back(std::move(entry));
+	return entries.size() - 1;
+}
+
+//==========================================================================
+// Class:			TemperatureSampler
+// Function:		Start
+//
+// Description:		Starts the worker threads.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false if already running
+//
+//==========================================================================
+bool TemperatureSampler::Start()
+{
+	if (!workerThreads.empty())
+		return false;
+
+	stopThreads = false;
+	unsigned int i;
+	for (i = 0; i < threadCount; i++)
+		workerThreads.push_back(std::thread(&TemperatureSampler::WorkerThreadEntry, this));
+
+	return true;
+}
+
+//==========================================================================
+// Class:			TemperatureSampler
+// Function:		Stop
+//
+// Description:		Stops the worker threads (after any reads in progress
+//					complete) and fails any outstanding requests.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void TemperatureSampler::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopThreads = true;
+	}
+
+	workAvailable.notify_all();
+	for (auto& thread : workerThreads)
+		thread.join();
+	workerThreads.clear();
+
+	std::lock_guard<std::mutex> lock(mutex);
+	for (auto& entry : entries)
+	{
+		for (auto& request : entry->pendingRequests)
+		{
+			Reading reading;
+			reading.valid = false;
+			reading.temperature = 0.0;
+			reading.time = Clock::now();
+			request.set_value(reading);
+		}
+
+		entry->pendingRequests.clear();
+	}
+}
+
+//==========================================================================
+// Class:			TemperatureSampler
+// Function:		TryGetLatest
+//
+// Description:		Returns the most recent reading from the specified sensor
+//					without blocking.
+//
+// Input Arguments:
+//		sensor	= const unsigned int&
+//
+// Output Arguments:
+//		reading	= Reading&
+//
+// Return Value:
+//		bool, true if a reading is available, false otherwise
+//
+//==========================================================================
+bool TemperatureSampler::TryGetLatest(const unsigned int& sensor, Reading& reading) const
+{
+	assert(sensor < entries.size());
+	const Entry& entry(*entries[sensor]);
+
+	unsigned int sequence;
+	do
+	{
+		sequence = entry.sequence.load(std::memory_order_acquire);
+		reading.valid = entry.valid.load(std::memory_order_relaxed);
+		reading.temperature = entry.temperature.load(std::memory_order_relaxed);
+		reading.time = Clock::time_point(Clock::duration(entry.time.load(std::memory_order_relaxed)));
+		std::atomic_thread_fence(std::memory_order_acquire);
+	} while ((sequence & 1) != 0 || sequence != entry.sequence.load(std::memory_order_relaxed));
+
+	return sequence != 0;
+}
+
+//==========================================================================
+// Class:			TemperatureSampler
+// Function:		RequestFresh
+//
+// Description:		Requests a reading that starts after this call.
+//
+// Input Arguments:
+//		sensor	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::future<Reading>
+//
+//==========================================================================
+std::future<TemperatureSampler::Reading> TemperatureSampler::RequestFresh(const unsigned int& sensor)
+{
+	assert(sensor < entries.size());
+
+	std::future<Reading> future;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		entries[sensor]->pendingRequests.push_back(std::promise<Reading>());
+		future = entries[sensor]->pendingRequests.back().get_future();
+	}
+
+	workAvailable.notify_all();
+	return future;
+}
+
+//==========================================================================
+// Class:			TemperatureSampler
+// Function:		WorkerThreadEntry
+//
+// Description:		Entry point for the worker threads.  Each thread reads
+//					whichever idle sensor is due soonest.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void TemperatureSampler::WorkerThreadEntry()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	while (!stopThreads)
+	{
+		Clock::time_point due;
+		Entry* entry(GetNextDue(due));
+		if (!entry || due == Clock::time_point::max())
+		{
+			workAvailable.wait(lock);
+			continue;
+		}
+
+		if (due > Clock::now())
+		{
+			// Something else may become due sooner - check again after waking
+			workAvailable.wait_until(lock, due);
+			continue;
+		}
+
+		// Requests made from here on need a later read
+		std::vector<std::promise<Reading>> requests(std::move(entry->pendingRequests));
+		entry->pendingRequests.clear();
+		entry->busy = true;
+		if (entry->period > Clock::duration::zero())
+			entry->nextDue = Clock::now() + entry->period;
+
+		lock.unlock();
+
+		double temperature;
+		const bool valid(entry->sensor->GetTemperature(temperature));
+		const Reading reading(Publish(*entry, valid, temperature));
+		for (auto& request : requests)
+			request.set_value(reading);
+
+		lock.lock();
+		entry->busy = false;
+
+		// Another thread may be waiting on requests made while we were busy
+		if (!entry->pendingRequests.empty())
+			workAvailable.notify_all();
+	}
+}
+
+//==========================================================================
+// Class:			TemperatureSampler
+// Function:		GetNextDue
+//
+// Description:		Finds the idle sensor that is due soonest.  Sensors with
+//					outstanding requests are due immediately.  Must be called
+//					with the mutex locked.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		due	= Clock::time_point&
+//
+// Return Value:
+//		Entry*, nullptr if all sensors are busy
+//
+//==========================================================================
+TemperatureSampler::Entry* TemperatureSampler::GetNextDue(Clock::time_point& due)
+{
+	Entry* next(nullptr);
+	for (auto& entry : entries)
+	{
+		if (entry->busy)
+			continue;
+
+		const Clock::time_point entryDue(entry->pendingRequests.empty() ?
+			entry->nextDue : Clock::time_point::min());
+		if (!next || entryDue < due)
+		{
+			next = entry.get();
+			due = entryDue;
+		}
+	}
+
+	return next;
+}
+
+//==========================================================================
+// Class:			TemperatureSampler
+// Function:		Publish
+//
+// Description:		Stores the result of a read so that it can be retrieved
+//					with TryGetLatest.
+//
+// Input Arguments:
+//		entry		= Entry&
+//		valid		= const bool&
+//		temperature	= const double& [deg C]
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		Reading, as stored
+//
+//==========================================================================
+TemperatureSampler::Reading TemperatureSampler::Publish(Entry& entry, const bool& valid,
+	const double& temperature)
+{
+	Reading reading;
+	reading.valid = valid;
+	reading.temperature = valid ? temperature : entry.temperature.load(std::memory_order_relaxed);
+	reading.time = Clock::now();
+
+	const unsigned int sequence(entry.sequence.load(std::memory_order_relaxed));
+	entry.sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	entry.valid.store(reading.valid, std::memory_order_relaxed);
+	entry.temperature.store(reading.temperature, std::memory_order_relaxed);
+	entry.time.store(reading.time.time_since_epoch().count(), std::memory_order_relaxed);
+
+	entry.sequence.store(sequence + 2, std::memory_order_release);
+	return reading;
+}
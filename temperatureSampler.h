@@ -0,0 +1,91 @@
+// File:  temperatureSampler.h
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  Reads a set of temperature sensors on worker threads, each at its own
+//        rate, and keeps the most recent reading from each so that control
+//        loops can get a temperature without waiting for a conversion.
+
+#ifndef TEMPERATURE_SAMPLER_H_
+#define TEMPERATURE_SAMPLER_H_
+
+// Standard C++ headers
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <chrono>
+
+// Local headers
+#include "temperatureSensor.h"
+
+class TemperatureSampler
+{
+public:
+	// Sensors on the same 1-wire bus are read one at a time by the kernel, so
+	// more than one thread only helps with sensors on different buses
+	TemperatureSampler(const unsigned int& threadCount = 1);
+	~TemperatureSampler();
+
+	// Returns the sensor index.  Add all sensors before calling Start.  A
+	// period of zero means the sensor is only read when RequestFresh is called.
+	unsigned int AddSensor(std::unique_ptr<TemperatureSensor> sensor,
+		const std::chrono::milliseconds& period);
+
+	bool Start();
+	void Stop();
+
+	typedef std::chrono::steady_clock Clock;
+
+	struct Reading
+	{
+		bool valid;// False if the most recent read failed
+		double temperature;// [deg C], from the most recent successful read
+		Clock::time_point time;// Of the most recent read
+	};
+
+	// Never blocks.  Returns false if the sensor hasn't been read yet.
+	bool TryGetLatest(const unsigned int& sensor, Reading& reading) const;
+
+	// The future is satisfied by a read that starts after this call (ahead of
+	// the sensor's schedule, if necessary).  Requests still pending when Stop
+	// is called are satisfied with an invalid reading.
+	std::future<Reading> RequestFresh(const unsigned int& sensor);
+
+private:
+	const unsigned int threadCount;
+
+	struct Entry
+	{
+		std::unique_ptr<TemperatureSensor> sensor;
+		Clock::duration period;
+
+		// Protected by mutex
+		Clock::time_point nextDue;
+		bool busy;
+		std::vector<std::promise<Reading>> pendingRequests;
+
+		// Latest reading, protected by a sequence lock (odd while being
+		// written, zero if no reading has been made)
+		std::atomic<unsigned int> sequence;
+		std::atomic<bool> valid;
+		std::atomic<double> temperature;
+		std::atomic<Clock::rep> time;
+	};
+
+	std::vector<std::unique_ptr<Entry>> entries;
+
+	std::mutex mutex;
+	std::condition_variable workAvailable;
+	bool stopThreads;
+	std::vector<std::thread> workerThreads;
+
+	void WorkerThreadEntry();
+	Entry* GetNextDue(Clock::time_point& due);
+	static Reading Publish(Entry& entry, const bool& valid, const double& temperature);
+};
+
+#endif// TEMPERATURE_SAMPLER_H_
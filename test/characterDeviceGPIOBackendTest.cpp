@@ -0,0 +1,334 @@
+// File:  characterDeviceGPIOBackendTest.cpp
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  Tests for CharacterDeviceGPIOBackend, run against an in-process fake
+//        GPIO chip.  Build from the repository root with:
+//        g++ -std=c++17 -pthread -I. test/characterDeviceGPIOBackendTest.cpp
+//            characterDeviceGPIOBackend.cpp gpioBackend.cpp gpio.cpp
+//            interrupt.cpp wiringPiGPIOBackend.cpp -lwiringPi
+
+// Standard C/C++ headers
+#include <cstring>
+#include <cerrno>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+
+// *nix standard headers
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+// Local headers
+#include "characterDeviceGPIOBackend.h"
+#include "gpio.h"
+#include "interrupt.h"
+
+// Mimics the kernel's handling of one line request on a chip.  Line request
+// descriptors are pipes, so the backend can read and poll them as usual.
+class FakeGPIOChip : public CharacterDeviceGPIOBackend::ChipDevice
+{
+public:
+	static const unsigned int lineCount = 54;
+
+	~FakeGPIOChip()
+	{
+		if (eventWriteFileDescriptor != -1)
+			close(eventWriteFileDescriptor);
+	}
+
+	virtual int Open(const std::string& /*chipFileName*/)
+	{
+		return eventfd(0, EFD_CLOEXEC);
+	}
+
+	virtual int Ioctl(const int& fileDescriptor, const unsigned long& request, void* argument)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (request == GPIO_GET_CHIPINFO_IOCTL)
+		{
+			gpiochip_info& info(*static_cast<gpiochip_info*>(argument));
+			memset(&info, 0, sizeof(info));
+			info.lines = lineCount;
+			return 0;
+		}
+		else if (request == GPIO_V2_GET_LINE_IOCTL)
+		{
+			gpio_v2_line_request& lineRequest(*static_cast<gpio_v2_line_request*>(argument));
+			int fileDescriptors[2];
+			if (pipe2(fileDescriptors, O_CLOEXEC) == -1)
+				return -1;
+
+			if (eventWriteFileDescriptor != -1)
+				close(eventWriteFileDescriptor);
+			eventWriteFileDescriptor = fileDescriptors[1];
+			requestFileDescriptor = fileDescriptors[0];
+			lineRequest.fd = requestFileDescriptor;
+
+			offsets.assign(lineRequest.offsets, lineRequest.offsets + lineRequest.num_lines);
+			ApplyConfig(lineRequest.config);
+			lineRequests++;
+			return 0;
+		}
+
+		if (fileDescriptor != requestFileDescriptor)
+		{
+			errno = EBADF;
+			return -1;
+		}
+
+		if (request == GPIO_V2_LINE_SET_CONFIG_IOCTL)
+		{
+			ApplyConfig(*static_cast<gpio_v2_line_config*>(argument));
+			return 0;
+		}
+
+		gpio_v2_line_values& values(*static_cast<gpio_v2_line_values*>(argument));
+		unsigned int i;
+		if (request == GPIO_V2_LINE_SET_VALUES_IOCTL)
+		{
+			for (i = 0; i < offsets.size(); i++)
+			{
+				if ((values.mask & (1ULL << i)) && (lineFlags[offsets[i]] & GPIO_V2_LINE_FLAG_OUTPUT))
+					levels[offsets[i]] = (values.bits & (1ULL << i)) != 0;
+			}
+
+			setValueCalls++;
+			return 0;
+		}
+		else if (request == GPIO_V2_LINE_GET_VALUES_IOCTL)
+		{
+			values.bits = 0;
+			for (i = 0; i < offsets.size(); i++)
+			{
+				if ((values.mask & (1ULL << i)) && levels[offsets[i]])
+					values.bits |= 1ULL << i;
+			}
+
+			return 0;
+		}
+
+		errno = EINVAL;
+		return -1;
+	}
+
+	// Changes the level of an input line, generating an edge event if enabled
+	void Drive(const unsigned int& offset, const bool& high)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (levels[offset] == high)
+			return;
+
+		levels[offset] = high;
+		const uint64_t edgeFlag(high ? GPIO_V2_LINE_FLAG_EDGE_RISING : GPIO_V2_LINE_FLAG_EDGE_FALLING);
+		if ((lineFlags[offset] & edgeFlag) == 0)
+			return;
+
+		gpio_v2_line_event event;
+		memset(&event, 0, sizeof(event));
+		event.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			Interrupt::Clock::now().time_since_epoch()).count();
+		event.id = high ? GPIO_V2_LINE_EVENT_RISING_EDGE : GPIO_V2_LINE_EVENT_FALLING_EDGE;
+		event.offset = offset;
+		if (write(eventWriteFileDescriptor, &event, sizeof(event)) != sizeof(event))
+			std::cerr << "Failed to write event:  " << strerror(errno) << std::endl;
+	}
+
+	bool GetLevel(const unsigned int& offset)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return levels[offset];
+	}
+
+	uint64_t GetFlags(const unsigned int& offset)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return lineFlags[offset];
+	}
+
+	std::atomic<unsigned int> lineRequests = {0};
+	std::atomic<unsigned int> setValueCalls = {0};
+
+private:
+	std::mutex mutex;
+	int requestFileDescriptor = -1;
+	int eventWriteFileDescriptor = -1;
+	std::vector<unsigned int> offsets;
+	uint64_t lineFlags[lineCount] = {};
+	bool levels[lineCount] = {};
+
+	void ApplyConfig(const gpio_v2_line_config& config)
+	{
+		unsigned int i, j;
+		for (i = 0; i < offsets.size(); i++)
+		{
+			uint64_t flags(config.flags);
+			for (j = 0; j < config.num_attrs; j++)
+			{
+				const gpio_v2_line_config_attribute& attribute(config.attrs[j]);
+				if ((attribute.mask & (1ULL << i)) == 0)
+					continue;
+
+				if (attribute.attr.id == GPIO_V2_LINE_ATTR_ID_FLAGS)
+					flags = attribute.attr.flags;
+				else if (attribute.attr.id == GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES)
+					levels[offsets[i]] = (attribute.attr.values & (1ULL << i)) != 0;
+			}
+
+			lineFlags[offsets[i]] = flags;
+		}
+	}
+};
+
+static unsigned int failures(0);
+
+static void Check(const bool& condition, const std::string& description)
+{
+	if (!condition)
+	{
+		std::cout << "FAILED:  " << description << std::endl;
+		failures++;
+	}
+}
+
+// Wiring Pi pins 0 - 3 are Broadcom GPIOs 17, 18, 27 and 22
+static const unsigned int offset0(17);
+static const unsigned int offset1(18);
+static const unsigned int offset2(27);
+static const unsigned int offset3(22);
+
+static bool WaitFor(const std::atomic<int>& value, const int& target)
+{
+	const auto deadline(std::chrono::steady_clock::now() + std::chrono::seconds(2));
+	while (value < target)
+	{
+		if (std::chrono::steady_clock::now() > deadline)
+			return false;
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	return true;
+}
+
+static void TestOutputs()
+{
+	FakeGPIOChip chip;
+	std::ostringstream messages;
+	CharacterDeviceGPIOBackend backend("fake", messages, "test", chip);
+	Check(backend.ChipOK(), "chip opened");
+
+	GPIO output0(0, GPIO::DataDirection::Output, backend);
+	GPIO output1(1, GPIO::DataDirection::Output, backend);
+	Check((chip.GetFlags(offset0) & GPIO_V2_LINE_FLAG_OUTPUT) != 0, "line configured as output");
+
+	output0.SetOutput(true);
+	Check(chip.GetLevel(offset0) && !chip.GetLevel(offset1), "single output set");
+
+	// Adding a line replaces the request; outputs must keep their values
+	GPIO output2(2, GPIO::DataDirection::Output, backend);
+	Check(chip.GetLevel(offset0), "output value survives a new line request");
+
+	const unsigned int callsBefore(chip.setValueCalls);
+	backend.SetOutputs({0, 1, 2}, 6, 7);
+	Check(chip.setValueCalls == callsBefore + 1, "bulk write uses one ioctl");
+	Check(!chip.GetLevel(offset0) && chip.GetLevel(offset1) && chip.GetLevel(offset2), "bulk write values");
+	Check(backend.GetInputs({0, 1, 2}) == 6, "bulk read values");
+
+	// Unconfigured pins are errors, not undefined behavior
+	Check(!backend.GetInput(3), "unconfigured pin reads low");
+	Check(backend.GetInputs({0, 3}) == 0, "bulk read with unconfigured pin fails");
+	Check(messages.str().find("has not been configured") != std::string::npos, "unconfigured pin reported");
+}
+
+static void TestEventQueue()
+{
+	FakeGPIOChip chip;
+	std::ostringstream messages;
+	CharacterDeviceGPIOBackend backend("fake", messages, "test", chip);
+
+	Interrupt interrupt(3, 16, Interrupt::EdgeDirection::Both, backend);
+	Check(interrupt.IsAttached(), "interrupt attached");
+
+	const auto before(Interrupt::Clock::now());
+	chip.Drive(offset3, true);
+	chip.Drive(offset3, false);
+
+	Check(interrupt.WaitForEvents(Interrupt::Clock::now() + std::chrono::seconds(2)), "events delivered");
+	while (interrupt.GetPendingEventCount() < 2 &&
+		interrupt.WaitForEvents(Interrupt::Clock::now() + std::chrono::milliseconds(100)))
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+	Interrupt::EdgeEvent events[4];
+	const size_t count(interrupt.GetEvents(events, 4));
+	Check(count == 2, "two edges queued");
+	if (count == 2)
+	{
+		Check(events[0].level && !events[1].level, "edge directions");
+		Check(events[0].time >= before && events[1].time >= events[0].time, "kernel timestamps used");
+	}
+}
+
+static CharacterDeviceGPIOBackend* isrBackend(nullptr);
+static std::atomic<int> isrCalls(0);
+static std::atomic<bool> isrRunning(false);
+
+// Uses the backend from within the service routine, which must not deadlock
+static void ReentrantISR()
+{
+	isrBackend->SetOutput(0, true);
+	isrBackend->SetDataDirection(1, GPIO::DataDirection::Output);
+	isrCalls++;
+}
+
+static void SlowISR()
+{
+	isrRunning = true;
+	isrCalls++;
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	isrRunning = false;
+}
+
+static void TestServiceRoutines()
+{
+	FakeGPIOChip chip;
+	std::ostringstream messages;
+	CharacterDeviceGPIOBackend backend("fake", messages, "test", chip);
+	isrBackend = &backend;
+
+	{
+		GPIO output(0, GPIO::DataDirection::Output, backend);
+		Interrupt interrupt(3, ReentrantISR, Interrupt::EdgeDirection::Rising, backend);
+		isrCalls = 0;
+		chip.Drive(offset3, true);
+		Check(WaitFor(isrCalls, 1), "reentrant service routine returns");
+		Check(chip.GetLevel(offset0), "service routine wrote an output");
+		Check((chip.GetFlags(offset1) & GPIO_V2_LINE_FLAG_OUTPUT) != 0, "service routine configured a line");
+		chip.Drive(offset3, false);
+	}
+
+	// Detaching must wait for a call in progress
+	{
+		Interrupt* interrupt(new Interrupt(3, SlowISR, Interrupt::EdgeDirection::Rising, backend));
+		isrCalls = 0;
+		chip.Drive(offset3, true);
+		Check(WaitFor(isrCalls, 1), "slow service routine called");
+		delete interrupt;
+		Check(!isrRunning, "detach waits for the service routine");
+	}
+}
+
+int main(int, char*[])
+{
+	TestOutputs();
+	TestEventQueue();
+	TestServiceRoutines();
+
+	if (failures == 0)
+		std::cout << "All tests passed" << std::endl;
+	return failures == 0 ? 0 : 1;
+}
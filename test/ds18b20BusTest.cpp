@@ -0,0 +1,165 @@
+// File:  ds18b20BusTest.cpp
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  Tests for DS18B20Bus, run against the fake 1-wire sysfs tree created
+//        by SimulatedBoard.  Build from the repository root with:
+//        g++ -std=c++17 -pthread -I. test/ds18b20BusTest.cpp ds18b20Bus.cpp
+//            ds18b20Sensor.cpp simulatedBoard.cpp gpio.cpp gpioBackend.cpp
+//            interrupt.cpp pwmOutput.cpp twi.cpp twiBus.cpp linuxI2CBackend.cpp
+//            wiringPiGPIOBackend.cpp wiringPiPWMBackend.cpp -lwiringPi
+
+// Standard C/C++ headers
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+
+// *nix standard headers
+#include <ftw.h>
+#include <unistd.h>
+
+// Local headers
+#include "ds18b20Bus.h"
+#include "simulatedBoard.h"
+
+static unsigned int failures(0);
+
+static void Check(const bool& condition, const std::string& description)
+{
+	if (!condition)
+	{
+		std::cout << "FAILED:  " << description << std::endl;
+		failures++;
+	}
+}
+
+static int RemoveEntry(const char* path, const struct stat* /*status*/, int /*type*/, struct FTW* /*ftw*/)
+{
+	return remove(path);
+}
+
+// Creates an empty directory for a fake 1-wire tree, removed on destruction
+class TemporaryDirectory
+{
+public:
+	TemporaryDirectory()
+	{
+		char name[] = "/tmp/ds18b20BusTestXXXXXX";
+		if (mkdtemp(name))
+			path = std::string(name) + "/";
+	}
+
+	~TemporaryDirectory()
+	{
+		if (!path.empty())
+			nftw(path.c_str(), RemoveEntry, 16, FTW_DEPTH | FTW_PHYS);
+	}
+
+	std::string path;
+};
+
+static const std::string sensor1("28-000005e2fdc3");
+static const std::string sensor2("28-000005e2fdc4");
+
+static std::string ReadBulkStatus(const std::string& w1Directory)
+{
+	std::ifstream file((w1Directory + "w1_bus_master1/therm_bulk_read").c_str());
+	std::string status;
+	file >> status;
+	return status;
+}
+
+static bool ReadingsMatch(const std::vector<DS18B20Bus::Reading>& readings,
+	const double& temperature1, const double& temperature2)
+{
+	return readings.size() == 2 &&
+		readings[0].valid && readings[1].valid &&
+		fabs(readings[0].temperature - (readings[0].deviceID == sensor1 ? temperature1 : temperature2)) < 1.0e-3 &&
+		fabs(readings[1].temperature - (readings[1].deviceID == sensor1 ? temperature1 : temperature2)) < 1.0e-3;
+}
+
+static void TestBulkConversion()
+{
+	TemporaryDirectory directory;
+	SimulatedBoard board(directory.path);
+	board.SetDS18B20ConversionTime(std::chrono::milliseconds(100));
+	Check(board.AddDS18B20(sensor1, 21.5) && board.AddDS18B20(sensor2, -3.25), "sensors added");
+	Check(ReadBulkStatus(board.GetW1DeviceDirectory()) == "0", "no conversion pending");
+
+	std::ostringstream messages;
+	DS18B20Bus bus(messages, board.GetW1DeviceDirectory());
+	Check(bus.BulkReadSupported(), "bulk read supported");
+	Check(bus.GetSensorIDs().size() == 2, "sensors found");
+
+	std::vector<DS18B20Bus::Reading> readings;
+	const auto start(std::chrono::steady_clock::now());
+	Check(bus.ReadAll(readings), "bulk read succeeds");
+	const auto elapsed(std::chrono::steady_clock::now() - start);
+
+	Check(ReadingsMatch(readings, 21.5, -3.25), "bulk read values");
+	Check(elapsed >= std::chrono::milliseconds(100), "waits for the conversion to finish");
+	Check(elapsed < std::chrono::milliseconds(500), "stops waiting once the conversion is done");
+	Check(ReadBulkStatus(board.GetW1DeviceDirectory()) == "1", "conversion reported complete");
+	Check(messages.str().find("Bulk conversion failed") == std::string::npos, "no fallback to single reads");
+
+	// And again, now that the attribute reads 1 to begin with
+	board.SetDS18B20Temperature(sensor1, 30.0);
+	messages.str(std::string());
+	Check(bus.ReadAll(readings) && ReadingsMatch(readings, 30.0, -3.25), "second bulk read");
+	Check(messages.str().find("Bulk conversion failed") == std::string::npos, "second read uses bulk conversion");
+}
+
+static void TestConversionTimeout()
+{
+	TemporaryDirectory directory;
+	SimulatedBoard board(directory.path);
+	board.SetDS18B20ConversionTime(std::chrono::seconds(3));
+	board.AddDS18B20(sensor1, 21.5);
+	board.AddDS18B20(sensor2, 22.5);
+
+	std::ostringstream messages;
+	DS18B20Bus bus(messages, board.GetW1DeviceDirectory());
+	std::vector<DS18B20Bus::Reading> readings;
+	Check(bus.ReadAll(readings), "read succeeds after timeout");
+	Check(ReadingsMatch(readings, 21.5, 22.5), "values read one at a time");
+	Check(messages.str().find("Timed out waiting for bulk conversion") != std::string::npos, "timeout reported");
+	Check(messages.str().find("Bulk conversion failed") != std::string::npos, "fell back to single reads");
+}
+
+static void TestUnexpectedStatus()
+{
+	TemporaryDirectory directory;
+	{
+		// Leaves the tree on disk, with nothing to respond to triggers
+		SimulatedBoard board(directory.path);
+		board.AddDS18B20(sensor1, 21.5);
+		board.AddDS18B20(sensor2, 22.5);
+	}
+
+	// The trigger command is read back, which must not be taken for "done"
+	std::ostringstream messages;
+	DS18B20Bus bus(messages, directory.path);
+	Check(bus.BulkReadSupported(), "bulk read attribute found");
+
+	std::vector<DS18B20Bus::Reading> readings;
+	Check(bus.ReadAll(readings), "read succeeds with unexpected status");
+	Check(ReadingsMatch(readings, 21.5, 22.5), "values read one at a time");
+	Check(messages.str().find("Unexpected bulk conversion status") != std::string::npos, "unexpected status reported");
+	Check(messages.str().find("Bulk conversion failed") != std::string::npos, "fell back to single reads");
+}
+
+int main(int, char*[])
+{
+	TestBulkConversion();
+	TestConversionTimeout();
+	TestUnexpectedStatus();
+
+	if (failures == 0)
+		std::cout << "All tests passed" << std::endl;
+	return failures == 0 ? 0 : 1;
+}
@@ -6,86 +6,282 @@
 // Standard C/C++ headers
 #include <cassert>
 #include <sstream>
-#include <fcntl.h>
+#include <algorithm>
 #include <string.h>
-#include <sys/ioctl.h>
-
-// Linux headers
-#include <linux/i2c-dev.h>
-#include <unistd.h>
 
 // Local headers
 #include "twi.h"
+#include "linuxI2CBackend.h"
+#include "twiBus.h"
 
-const unsigned int TWI::bufferSize(10);
+I2CBackend* TWI::defaultBackend(nullptr);
 
 TWI::TWI(const std::string& deviceFileName, const unsigned char& address,
-	std::ostream& outStream) : address(address), outStream(outStream)
+	std::ostream& outStream, I2CBackend& backend) : address(address),
+	backend(backend), bus(nullptr), maxChunkSize(I2CBackend::maxTransferSize),
+	outStream(outStream)
+{
+	busFileDescriptor = backend.Open(deviceFileName);
+}
+
+TWI::TWI(TWIBus& bus, const unsigned char& address, std::ostream& outStream)
+	: address(address), backend(bus.GetBackend()), bus(&bus), busFileDescriptor(-1),
+	maxChunkSize(I2CBackend::maxTransferSize), outStream(outStream)
 {
-	busFileDescriptor = open(deviceFileName.c_str(), O_RDWR);
-	buffer = new unsigned char[bufferSize];
 }
 
 TWI::~TWI()
 {
-	delete [] buffer;
+	if (busFileDescriptor != -1)
+		backend.Close(busFileDescriptor);
+}
+
+// Sizes of zero would never finish a transfer, and the backend can't take
+// more than maxTransferSize in one message
+void TWI::SetMaxChunkSize(const size_t& size)
+{
+	assert(size > 0 && size <= I2CBackend::maxTransferSize);
+	if (size == 0)
+		maxChunkSize = 1;
+	else if (size > I2CBackend::maxTransferSize)
+		maxChunkSize = I2CBackend::maxTransferSize;
+	else
+		maxChunkSize = size;
 }
 
 bool TWI::Write(const std::vector<unsigned char>& data) const
+{
+	return Write(data.data(), data.size());
+}
+
+bool TWI::Read(std::vector<unsigned char>& data,
+	const unsigned short& size) const
+{
+	data.resize(size);
+	return Read(data.data(), size);
+}
+
+// Data longer than the maximum chunk size is sent as several consecutive writes
+bool TWI::Write(const unsigned char* data, const size_t& size) const
 {
 	assert(ConnectionOK());
-	assert(data.size() > 0);
-	assert(data.size() < bufferSize);
+	assert(size > 0);
 
-	if (ioctl(busFileDescriptor, I2C_SLAVE, address) == -1)
+	if (!bus && !backend.SelectSlave(busFileDescriptor, address))
 	{
 		outStream << "Failed to get bus access:  " << GetErrorString() << std::endl;
 		return false;
 	}
 
-	unsigned int i;
-	for (i = 0; i < data.size(); i++)
-		buffer[i] = data[i];
+	size_t offset(0);
+	while (offset < size)
+	{
+		const size_t chunkSize(std::min(size - offset, maxChunkSize));
+		bool ok;
+		if (bus)
+			ok = bus->Write(address, data + offset, chunkSize);
+		else
+		{
+			const int writeSize(backend.Write(busFileDescriptor, data + offset, chunkSize));
+			if (writeSize != -1 && writeSize != static_cast<int>(chunkSize))
+			{
+				outStream << "Wrong number of bytes written" << std::endl;
+				return false;
+			}
+
+			ok = writeSize != -1;
+		}
+
+		if (!ok)
+		{
+			outStream << "Failed to write to slave:  " << GetErrorString() << std::endl;
+			return false;
+		}
+
+		offset += chunkSize;
+	}
+
+	return true;
+}
 
-	int writeSize = write(busFileDescriptor, buffer, data.size());
-	if (writeSize == -1)
+// Data longer than the maximum chunk size is read with several consecutive reads
+bool TWI::Read(unsigned char* data, const size_t& size) const
+{
+	assert(ConnectionOK());
+
+	size_t offset(0);
+	while (offset < size)
 	{
-		outStream << "Failed to write to slave:  " << GetErrorString() << std::endl;
-		return false;
+		const size_t chunkSize(std::min(size - offset, maxChunkSize));
+		bool ok;
+		if (bus)
+			ok = bus->Read(address, data + offset, chunkSize);
+		else
+		{
+			const int readSize(backend.Read(busFileDescriptor, data + offset, chunkSize));
+			if (readSize != -1 && readSize != static_cast<int>(chunkSize))
+			{
+				outStream << "Wrong number of bytes read" << std::endl;
+				return false;
+			}
+
+			ok = readSize != -1;
+		}
+
+		if (!ok)
+		{
+			outStream << "Failed to read from slave:  " << GetErrorString() << std::endl;
+			return false;
+		}
+
+		offset += chunkSize;
 	}
-	else if (writeSize != (int)data.size())
+
+	return true;
+}
+
+bool TWI::WriteRead(const std::vector<unsigned char>& writeData,
+	std::vector<unsigned char>& readData, const unsigned short& readSize) const
+{
+	readData.resize(readSize);
+	return WriteRead(writeData.data(), writeData.size(), readData.data(), readSize);
+}
+
+// The write and the first read chunks are done in one transaction; if the
+// read needs more chunks than fit in one transaction, the rest follow in
+// further transactions
+bool TWI::WriteRead(const unsigned char* writeData, const size_t& writeSize,
+	unsigned char* readData, const size_t& readSize) const
+{
+	assert(ConnectionOK());
+	assert(writeSize > 0 || readSize > 0);
+
+	// Splitting the write would restart it in the middle (e.g. the second
+	// part would be taken for a register address)
+	if (writeSize > maxChunkSize)
 	{
-		outStream << "Wrong number of bytes written" << std::endl;
+		outStream << "Write of " << writeSize << " bytes exceeds the maximum chunk size ("
+			<< maxChunkSize << " bytes)" << std::endl;
+		assert(false);
 		return false;
 	}
 
+	I2CBackend::Message messages[I2CBackend::maxTransferMessages];
+	size_t count(0);
+	if (writeSize > 0)
+	{
+		// i2c_msg isn't const-correct, but write buffers aren't modified
+		messages[count].address = address;
+		messages[count].read = false;
+		messages[count].data = const_cast<unsigned char*>(writeData);
+		messages[count].size = writeSize;
+		count++;
+	}
+
+	size_t offset(0);
+	do
+	{
+		for (; offset < readSize && count < I2CBackend::maxTransferMessages; count++)
+		{
+			messages[count].address = address;
+			messages[count].read = true;
+			messages[count].data = readData + offset;
+			messages[count].size = std::min(readSize - offset, maxChunkSize);
+			offset += messages[count].size;
+		}
+
+		if (!TransferMessages(messages, count))
+			return false;
+		count = 0;
+	} while (offset < readSize);
+
 	return true;
 }
 
-bool TWI::Read(std::vector<unsigned char>& data,
-	const unsigned short& size) const
+bool TWI::Transfer(Transaction& transaction) const
+{
+	std::vector<Transaction> transactions(1);
+	transactions.front().writeData.swap(transaction.writeData);
+	transactions.front().readSize = transaction.readSize;
+
+	const bool ok(Transfer(transactions));
+	transaction.writeData.swap(transactions.front().writeData);
+	transaction.readData.swap(transactions.front().readData);
+	return ok;
+}
+
+bool TWI::Transfer(std::vector<Transaction>& transactions) const
 {
 	assert(ConnectionOK());
-	assert(size <= bufferSize);
 
-	int readSize = read(busFileDescriptor, buffer, size);
-	if (readSize == -1)
+	for (const auto& transaction : transactions)
 	{
-		outStream << "Failed to read from slave:  " << GetErrorString() << std::endl;
-		return false;
+		if (transaction.writeData.size() > maxChunkSize || transaction.readSize > maxChunkSize)
+		{
+			outStream << "Transaction exceeds the maximum chunk size ("
+				<< maxChunkSize << " bytes)" << std::endl;
+			assert(false);
+			return false;
+		}
 	}
 
-	data.resize(readSize);
-	int i;
-	for (i = 0; i < readSize; i++)
-		data[i] = buffer[i];
+	std::vector<I2CBackend::Message> messages;
+	messages.reserve(2 * transactions.size());
+
+	auto it(transactions.begin());
+	while (it != transactions.end())
+	{
+		messages.clear();
+		for (; it != transactions.end(); ++it)
+		{
+			const size_t messageCount((it->writeData.empty() ? 0 : 1) + (it->readSize == 0 ? 0 : 1));
+			assert(messageCount > 0);
+			if (messages.size() + messageCount > I2CBackend::maxTransferMessages)
+				break;
+
+			I2CBackend::Message message;
+			message.address = address;
+			if (!it->writeData.empty())
+			{
+				message.read = false;
+				message.data = it->writeData.data();
+				message.size = it->writeData.size();
+				messages.push_back(message);
+			}
+
+			it->readData.resize(it->readSize);
+			if (it->readSize > 0)
+			{
+				message.read = true;
+				message.data = it->readData.data();
+				message.size = it->readSize;
+				messages.push_back(message);
+			}
+		}
+
+		if (!TransferMessages(messages.data(), messages.size()))
+			return false;
+	}
 
 	return true;
 }
 
+bool TWI::TransferMessages(I2CBackend::Message* messages, const size_t& count) const
+{
+	const bool ok(bus ? bus->Transfer(messages, count) :
+		backend.Transfer(busFileDescriptor, messages, count));
+	if (!ok)
+		outStream << "Failed to transfer with slave:  " << GetErrorString() << std::endl;
+
+	return ok;
+}
+
 bool TWI::ConnectionOK() const
 {
-	return busFileDescriptor != -1 && buffer;
+	if (bus)
+		return bus->ConnectionOK();
+
+	return busFileDescriptor != -1;
 }
 
 std::string TWI::GetErrorString() const
@@ -94,3 +290,20 @@ std::string TWI::GetErrorString() const
 	ss << "(" << errno << ") " << strerror(errno);
 	return ss.str();
 }
+
+// Returns the backend used when none is specified at construction (the
+// Linux i2c-dev interface unless SetDefaultBackend was called)
+I2CBackend& TWI::GetDefaultBackend()
+{
+	if (defaultBackend)
+		return *defaultBackend;
+
+	static LinuxI2CBackend linuxBackend;
+	return linuxBackend;
+}
+
+// The backend must outlive any objects constructed after this call
+void TWI::SetDefaultBackend(I2CBackend& backend)
+{
+	defaultBackend = &backend;
+}
@@ -11,27 +11,79 @@
 #include <vector>
 #include <iostream>
 
+// Local headers
+#include "i2cBackend.h"
+
+class TWIBus;
+
 class TWI
 {
 public:
 	TWI(const std::string& deviceFileName, const unsigned char& address,
-		std::ostream& outStream = std::cout);
+		std::ostream& outStream = std::cout, I2CBackend& backend = GetDefaultBackend());
+
+	// Lightweight handle for a device on a shared bus - the bus must outlive it
+	TWI(TWIBus& bus, const unsigned char& address, std::ostream& outStream = std::cout);
 	virtual ~TWI();
 
 	bool Write(const std::vector<unsigned char>& data) const;
 	bool Read(std::vector<unsigned char>& data,
 		const unsigned short& size) const;
 
+	// Caller-owned buffers of any length, read and written in place.  Data
+	// longer than the maximum chunk size is split into several transfers, so
+	// only use long buffers with devices that expect that (FIFOs, EEPROM
+	// sequential reads, etc.).  The write part of WriteRead is never split,
+	// and must not be longer than the maximum chunk size.
+	bool Write(const unsigned char* data, const size_t& size) const;
+	bool Read(unsigned char* data, const size_t& size) const;
+	bool WriteRead(const unsigned char* writeData, const size_t& writeSize,
+		unsigned char* readData, const size_t& readSize) const;
+
+	// Defaults to the i2c-dev limit (also the upper limit); some adapters
+	// need less.  Must be at least one byte.
+	void SetMaxChunkSize(const size_t& size);
+	size_t GetMaxChunkSize() const { return maxChunkSize; }
+
+	// Combined write-then-read with a repeated start in between (e.g. send a
+	// register address, then read the register contents), in one system call
+	struct Transaction
+	{
+		std::vector<unsigned char> writeData;// Sent first, unless empty
+		unsigned short readSize = 0;// Then this many bytes are read, unless zero
+		std::vector<unsigned char> readData;// Filled in by Transfer
+	};
+
+	bool WriteRead(const std::vector<unsigned char>& writeData,
+		std::vector<unsigned char>& readData, const unsigned short& readSize) const;
+	bool Transfer(Transaction& transaction) const;
+
+	// Transactions are chained with repeated starts, so no other bus master
+	// can get in between - but only within one I2C_RDWR call, which holds at
+	// most I2CBackend::maxTransferMessages messages.  Longer lists are split
+	// into as few calls as possible, between transactions, and another master
+	// can take the bus between those calls.  Reads and writes are not
+	// split, so none may be longer than the maximum chunk size; nothing is
+	// sent if one is.
+	bool Transfer(std::vector<Transaction>& transactions) const;
+
 	bool ConnectionOK() const;
 
 	std::string GetErrorString() const;
 
+	static I2CBackend& GetDefaultBackend();
+	static void SetDefaultBackend(I2CBackend& backend);
+
 private:
 	const unsigned char address;
+	I2CBackend& backend;
+	static I2CBackend* defaultBackend;
+	TWIBus* const bus;// nullptr if we have our own file descriptor
 
 	int busFileDescriptor;
-	static const unsigned int bufferSize;
-	unsigned char *buffer;
+	size_t maxChunkSize;
+
+	bool TransferMessages(I2CBackend::Message* messages, const size_t& count) const;
 
 protected:
 	std::ostream& outStream;
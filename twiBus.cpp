@@ -0,0 +1,137 @@
+// File:  twiBus.cpp
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Desc:  Object representing one I2C bus (/dev/i2c-N), shared by any number
+//        of TWI objects.  Owns a single file descriptor, serializes access
+//        from multiple threads, only re-selects the slave address when it
+//        changes and keeps track of how busy the bus is.
+
+// Standard C/C++ headers
+#include <cassert>
+#include <cerrno>
+#include <string.h>
+
+// Local headers
+#include "twiBus.h"
+
+TWIBus::TWIBus(const std::string& deviceFileName, std::ostream& outStream,
+	I2CBackend& backend) : backend(backend), outStream(outStream), selectedAddress(-1),
+	statisticsStart(Clock::now())
+{
+	busFileDescriptor = backend.Open(deviceFileName);
+	if (busFileDescriptor == -1)
+		outStream << "Failed to open '" << deviceFileName << "':  " << strerror(errno) << std::endl;
+}
+
+TWIBus::~TWIBus()
+{
+	if (busFileDescriptor != -1)
+		backend.Close(busFileDescriptor);
+}
+
+bool TWIBus::Write(const unsigned char& address, const unsigned char* data, const size_t& size)
+{
+	assert(ConnectionOK());
+	std::unique_lock<std::mutex> lock(Lock());
+
+	const Clock::time_point start(Clock::now());
+	const bool ok(SelectSlave(address) &&
+		backend.Write(busFileDescriptor, data, size) == static_cast<int>(size));
+	RecordOperation(ok, size, start);
+	return ok;
+}
+
+bool TWIBus::Read(const unsigned char& address, unsigned char* data, const size_t& size)
+{
+	assert(ConnectionOK());
+	std::unique_lock<std::mutex> lock(Lock());
+
+	const Clock::time_point start(Clock::now());
+	const bool ok(SelectSlave(address) &&
+		backend.Read(busFileDescriptor, data, size) == static_cast<int>(size));
+	RecordOperation(ok, size, start);
+	return ok;
+}
+
+bool TWIBus::Transfer(I2CBackend::Message* messages, const size_t& count)
+{
+	assert(ConnectionOK());
+	std::unique_lock<std::mutex> lock(Lock());
+
+	// Addresses are part of each message, so the selected slave doesn't matter
+	const Clock::time_point start(Clock::now());
+	const bool ok(backend.Transfer(busFileDescriptor, messages, count));
+
+	size_t size(0), i;
+	for (i = 0; i < count; i++)
+		size += messages[i].size;
+
+	RecordOperation(ok, size, start);
+	return ok;
+}
+
+TWIBus::Statistics TWIBus::GetStatistics() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	Statistics s(statistics);
+	s.elapsedTime = Clock::now() - statisticsStart;
+	return s;
+}
+
+void TWIBus::ResetStatistics()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	statistics = Statistics();
+	statisticsStart = Clock::now();
+}
+
+double TWIBus::GetUtilization() const
+{
+	const Statistics s(GetStatistics());
+	if (s.elapsedTime <= Clock::duration::zero())
+		return 0.0;
+
+	return std::chrono::duration<double>(s.busyTime).count() /
+		std::chrono::duration<double>(s.elapsedTime).count();
+}
+
+// Locks the bus, counting the times we had to wait for another thread
+std::unique_lock<std::mutex> TWIBus::Lock()
+{
+	std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+	if (!lock.owns_lock())
+	{
+		lock.lock();
+		statistics.contendedLocks++;
+	}
+
+	return lock;
+}
+
+// Caller must hold the lock
+bool TWIBus::SelectSlave(const unsigned char& address)
+{
+	if (selectedAddress == address)
+		return true;
+
+	if (!backend.SelectSlave(busFileDescriptor, address))
+	{
+		selectedAddress = -1;
+		return false;
+	}
+
+	selectedAddress = address;
+	statistics.slaveSelects++;
+	return true;
+}
+
+// Caller must hold the lock
+void TWIBus::RecordOperation(const bool& ok, const size_t& size, const Clock::time_point& start)
+{
+	statistics.busyTime += Clock::now() - start;
+	statistics.operations++;
+	if (ok)
+		statistics.bytes += size;
+	else
+		statistics.failures++;
+}
@@ -0,0 +1,75 @@
+// File:  twiBus.h
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Desc:  Object representing one I2C bus (/dev/i2c-N), shared by any number
+//        of TWI objects.  Owns a single file descriptor, serializes access
+//        from multiple threads, only re-selects the slave address when it
+//        changes and keeps track of how busy the bus is.
+
+#ifndef TWI_BUS_H_
+#define TWI_BUS_H_
+
+// Standard C++ headers
+#include <string>
+#include <mutex>
+#include <chrono>
+#include <iostream>
+#include <cstdint>
+
+// Local headers
+#include "i2cBackend.h"
+#include "twi.h"
+
+class TWIBus
+{
+public:
+	TWIBus(const std::string& deviceFileName, std::ostream& outStream = std::cout,
+		I2CBackend& backend = TWI::GetDefaultBackend());
+	~TWIBus();
+
+	TWIBus(const TWIBus&) = delete;
+	TWIBus& operator=(const TWIBus&) = delete;
+
+	bool ConnectionOK() const { return busFileDescriptor != -1; }
+	I2CBackend& GetBackend() const { return backend; }
+
+	// These mirror I2CBackend:  failures return false and leave the reason
+	// in errno.  Device handles (TWI objects constructed with this bus) call
+	// these for you.
+	bool Write(const unsigned char& address, const unsigned char* data, const size_t& size);
+	bool Read(const unsigned char& address, unsigned char* data, const size_t& size);
+	bool Transfer(I2CBackend::Message* messages, const size_t& count);
+
+	typedef std::chrono::steady_clock Clock;
+
+	struct Statistics
+	{
+		uint64_t operations = 0;// Writes, reads and transfers
+		uint64_t failures = 0;
+		uint64_t bytes = 0;
+		uint64_t slaveSelects = 0;// Address changes (unchanged addresses aren't re-selected)
+		uint64_t contendedLocks = 0;// Operations that had to wait for another thread
+		Clock::duration busyTime = Clock::duration::zero();// Time spent in the backend
+		Clock::duration elapsedTime = Clock::duration::zero();// Since the last reset
+	};
+
+	Statistics GetStatistics() const;
+	void ResetStatistics();
+	double GetUtilization() const;// Fraction of the time the bus was busy since the last reset
+
+private:
+	I2CBackend& backend;
+	std::ostream& outStream;
+	int busFileDescriptor;
+
+	mutable std::mutex mutex;
+	int selectedAddress;// -1 if unknown
+	Statistics statistics;
+	Clock::time_point statisticsStart;
+
+	std::unique_lock<std::mutex> Lock();
+	bool SelectSlave(const unsigned char& address);
+	void RecordOperation(const bool& ok, const size_t& size, const Clock::time_point& start);
+};
+
+#endif// TWI_BUS_H_
@@ -0,0 +1,252 @@
+// File:  twiFIFOReader.cpp
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Desc:  Streams samples from a TWI device with an on-chip FIFO (IMUs, etc.).
+//        A background thread periodically reads the FIFO count register, then
+//        drains the FIFO with burst reads into a preallocated, lock-free ring
+//        buffer of timestamped samples, which a consumer collects in blocks.
+
+// Standard C/C++ headers
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+
+// *nix standard headers
+#include <pthread.h>
+
+// Local headers
+#include "twiFIFOReader.h"
+
+TWIFIFOReader::TWIFIFOReader(TWI& device, const Configuration& configuration,
+	const size_t& bufferSize, std::ostream& outStream) : device(device),
+	configuration(configuration), outStream(outStream), buffer(bufferSize),
+	readBuffer(configuration.maxSamplesPerRead * configuration.sampleSize),
+	stopPolling(false), waiterCount(0), polls(0), emptyPolls(0), sampleCount(0),
+	overruns(0), underruns(0), deviceOverflows(0), readFailures(0), maxPollLateness(0)
+{
+	assert(configuration.countSize == 1 || configuration.countSize == 2);
+	assert(configuration.sampleSize > 0 && configuration.sampleSize <= maxSampleSize);
+	assert(configuration.maxSamplesPerRead > 0);
+}
+
+TWIFIFOReader::~TWIFIFOReader()
+{
+	Stop();
+}
+
+bool TWIFIFOReader::Start(const std::chrono::microseconds& period, const int& realTimePriority)
+{
+	if (pollThread.joinable())
+		return false;
+
+	stopPolling = false;
+	pollThread = std::thread(&TWIFIFOReader::PollThreadEntry, this, period);
+
+	if (realTimePriority > 0)
+	{
+		sched_param parameters;
+		memset(&parameters, 0, sizeof(parameters));
+		parameters.sched_priority = realTimePriority;
+		const int result(pthread_setschedparam(pollThread.native_handle(), SCHED_FIFO, &parameters));
+		if (result != 0)
+			outStream << "Failed to set real-time priority:  " << strerror(result) << std::endl;
+	}
+
+	return true;
+}
+
+void TWIFIFOReader::Stop()
+{
+	if (!pollThread.joinable())
+		return;
+
+	stopPolling = true;
+	pollThread.join();
+}
+
+size_t TWIFIFOReader::GetSamples(Sample* samples, const size_t& maxSamples)
+{
+	return buffer.Pop(samples, maxSamples);
+}
+
+bool TWIFIFOReader::GetBlock(Sample* samples, const size_t& blockSize)
+{
+	// Only the producer changes the size in the meantime, and it only grows
+	if (buffer.GetSize() < blockSize)
+	{
+		underruns++;
+		return false;
+	}
+
+	const size_t count(buffer.Pop(samples, blockSize));
+	assert(count == blockSize);
+	(void)count;
+	return true;
+}
+
+bool TWIFIFOReader::WaitForSamples(const size_t& count, const Clock::time_point& deadline)
+{
+	assert(count <= buffer.GetCapacity());
+
+	std::unique_lock<std::mutex> lock(waitMutex);
+	waiterCount++;
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	const bool available(samplesAvailable.wait_until(lock, deadline, [this, count]()
+	{
+		return buffer.GetSize() >= count;
+	}));
+	waiterCount--;
+
+	return available;
+}
+
+TWIFIFOReader::Statistics TWIFIFOReader::GetStatistics() const
+{
+	Statistics statistics;
+	statistics.polls = polls;
+	statistics.emptyPolls = emptyPolls;
+	statistics.samples = sampleCount;
+	statistics.overruns = overruns;
+	statistics.underruns = underruns;
+	statistics.deviceOverflows = deviceOverflows;
+	statistics.readFailures = readFailures;
+	statistics.maxPollLateness = Clock::duration(maxPollLateness);
+	return statistics;
+}
+
+void TWIFIFOReader::ResetStatistics()
+{
+	polls = 0;
+	emptyPolls = 0;
+	sampleCount = 0;
+	overruns = 0;
+	underruns = 0;
+	deviceOverflows = 0;
+	readFailures = 0;
+	maxPollLateness = 0;
+}
+
+void TWIFIFOReader::PollThreadEntry(const std::chrono::microseconds period)
+{
+	auto nextTime(Clock::now());
+	while (!stopPolling)
+	{
+		Poll();
+
+		nextTime += period;
+		const bool overran(Clock::now() >= nextTime);
+		if (!overran)
+			std::this_thread::sleep_until(nextTime);
+
+		// Lateness is measured against the scheduled time, before an overrun
+		// moves the schedule
+		const Clock::time_point startTime(Clock::now());
+		const Clock::rep lateness((startTime - nextTime).count());
+		Clock::rep maxLateness(maxPollLateness.load(std::memory_order_relaxed));
+		while (lateness > maxLateness &&
+			!maxPollLateness.compare_exchange_weak(maxLateness, lateness, std::memory_order_relaxed))
+		{
+		}
+
+		// If a poll overruns the period, start the next one right away rather
+		// than trying to catch up - the FIFO holds whatever we missed
+		if (overran)
+			nextTime = startTime;
+	}
+}
+
+void TWIFIFOReader::Poll()
+{
+	polls++;
+
+	// All samples in the FIFO were taken no later than this
+	const Clock::time_point readTime(Clock::now());
+
+	size_t count;
+	if (!ReadCount(count))
+	{
+		readFailures++;
+		return;
+	}
+
+	if (count == 0)
+	{
+		emptyPolls++;
+		return;
+	}
+
+	if (configuration.fifoCapacity > 0 && count >= configuration.fifoCapacity)
+		deviceOverflows++;
+
+	size_t offset(0);
+	while (offset < count)
+	{
+		const size_t chunk(std::min(count - offset, configuration.maxSamplesPerRead));
+		if (!device.WriteRead(&configuration.dataRegister, 1, readBuffer.data(),
+			chunk * configuration.sampleSize))
+		{
+			outStream << "Failed to read FIFO data" << std::endl;
+			readFailures++;
+			break;
+		}
+
+		Store(chunk, readTime, count - 1 - offset);
+		offset += chunk;
+	}
+
+	// Only take the lock if a consumer is blocked in WaitForSamples
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (offset > 0 && waiterCount > 0)
+	{
+		{
+			std::lock_guard<std::mutex> lock(waitMutex);
+		}
+		samplesAvailable.notify_all();
+	}
+}
+
+bool TWIFIFOReader::ReadCount(size_t& count)
+{
+	unsigned char data[2];
+	if (!device.WriteRead(&configuration.countRegister, 1, data, configuration.countSize))
+	{
+		outStream << "Failed to read FIFO count" << std::endl;
+		return false;
+	}
+
+	unsigned short value;
+	if (configuration.countSize == 1)
+		value = data[0];
+	else if (configuration.countBigEndian)
+		value = (data[0] << 8) | data[1];
+	else
+		value = (data[1] << 8) | data[0];
+
+	count = value & configuration.countMask;
+	if (configuration.countInBytes)
+		count /= configuration.sampleSize;// A partial sample stays in the FIFO until next time
+
+	return true;
+}
+
+// samplesBehind is the number of samples between the first one in the read
+// buffer and the newest one in the FIFO
+void TWIFIFOReader::Store(const size_t& count, const Clock::time_point& time, const size_t& samplesBehind)
+{
+	Sample sample;
+	size_t i;
+	for (i = 0; i < count; i++)
+	{
+		// Never earlier than samples already stored, in case the device runs
+		// faster than the configured sample period
+		const Clock::time_point estimate(time - configuration.samplePeriod * static_cast<int>(samplesBehind - i));
+		sample.time = std::max(estimate, lastSampleTime);
+		lastSampleTime = sample.time;
+		memcpy(sample.data.data(), readBuffer.data() + i * configuration.sampleSize, configuration.sampleSize);
+
+		if (!buffer.Push(sample))
+			overruns++;
+	}
+
+	sampleCount += count;
+}
@@ -0,0 +1,121 @@
+// File:  twiFIFOReader.h
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Desc:  Streams samples from a TWI device with an on-chip FIFO (IMUs, etc.).
+//        A background thread periodically reads the FIFO count register, then
+//        drains the FIFO with burst reads into a preallocated, lock-free ring
+//        buffer of timestamped samples, which a consumer collects in blocks.
+
+#ifndef TWI_FIFO_READER_H_
+#define TWI_FIFO_READER_H_
+
+// Standard C++ headers
+#include <array>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <iostream>
+#include <cstdint>
+
+// Local headers
+#include "twi.h"
+#include "spscRingBuffer.h"
+
+class TWIFIFOReader
+{
+public:
+	typedef std::chrono::steady_clock Clock;
+
+	static const size_t maxSampleSize = 32;
+
+	struct Configuration
+	{
+		unsigned char countRegister;
+		unsigned char countSize = 1;// 1 or 2 bytes
+		bool countBigEndian = false;
+		unsigned short countMask = 0xFFFF;// For count registers that share bits with flags
+		bool countInBytes = false;// Otherwise the count is in samples
+
+		unsigned char dataRegister;// Burst reads from here drain the FIFO
+		size_t sampleSize;// Bytes per sample (up to maxSampleSize)
+		size_t maxSamplesPerRead = 32;// Longest single burst read
+
+		size_t fifoCapacity = 0;// In samples; if non-zero, a full FIFO is counted as a device overflow
+
+		// The device's sample period (output data rate).  If non-zero, samples
+		// drained together are timestamped this far apart, ending at the time
+		// of the read; otherwise all get the time of the read.
+		std::chrono::microseconds samplePeriod = std::chrono::microseconds::zero();
+	};
+
+	struct Sample
+	{
+		Clock::time_point time;
+		std::array<unsigned char, maxSampleSize> data;// First sampleSize bytes are valid
+	};
+
+	TWIFIFOReader(TWI& device, const Configuration& configuration,
+		const size_t& bufferSize, std::ostream& outStream = std::cout);
+	~TWIFIFOReader();
+
+	// Polls the FIFO every period.  A positive realTimePriority runs the
+	// polling thread with SCHED_FIFO at that priority.
+	bool Start(const std::chrono::microseconds& period, const int& realTimePriority = 0);
+	void Stop();
+
+	// Consumer side; call from a single thread
+	size_t GetSamples(Sample* samples, const size_t& maxSamples);// Takes whatever is available
+	bool GetBlock(Sample* samples, const size_t& blockSize);// All or nothing; false is an underrun
+	bool WaitForSamples(const size_t& count, const Clock::time_point& deadline);// Returns false on timeout
+	size_t GetAvailableSampleCount() const { return buffer.GetSize(); }
+
+	struct Statistics
+	{
+		uint64_t polls = 0;
+		uint64_t emptyPolls = 0;// FIFO had nothing new
+		uint64_t samples = 0;// Read from the device
+		uint64_t overruns = 0;// Samples dropped because the ring buffer was full
+		uint64_t underruns = 0;// GetBlock calls with too few samples available
+		uint64_t deviceOverflows = 0;// Polls that found the device FIFO full (see fifoCapacity)
+		uint64_t readFailures = 0;
+		Clock::duration maxPollLateness = Clock::duration::zero();
+	};
+
+	Statistics GetStatistics() const;
+	void ResetStatistics();
+
+private:
+	TWI& device;
+	const Configuration configuration;
+	std::ostream& outStream;
+
+	SPSCRingBuffer<Sample> buffer;
+	std::vector<unsigned char> readBuffer;
+	Clock::time_point lastSampleTime;
+
+	std::thread pollThread;
+	std::atomic<bool> stopPolling;
+
+	std::atomic<unsigned int> waiterCount;
+	std::mutex waitMutex;
+	std::condition_variable samplesAvailable;
+
+	std::atomic<uint64_t> polls;
+	std::atomic<uint64_t> emptyPolls;
+	std::atomic<uint64_t> sampleCount;
+	std::atomic<uint64_t> overruns;
+	std::atomic<uint64_t> underruns;
+	std::atomic<uint64_t> deviceOverflows;
+	std::atomic<uint64_t> readFailures;
+	std::atomic<Clock::rep> maxPollLateness;
+
+	void PollThreadEntry(const std::chrono::microseconds period);
+	void Poll();
+	bool ReadCount(size_t& count);
+	void Store(const size_t& count, const Clock::time_point& time, const size_t& samplesBehind);
+};
+
+#endif// TWI_FIFO_READER_H_
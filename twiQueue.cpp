@@ -0,0 +1,278 @@
+// File:  twiQueue.cpp
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Desc:  Asynchronous transaction queue for a shared TWIBus.  A worker thread
+//        performs queued transactions in priority order (earliest deadline
+//        first within each priority), so that a control loop doesn't stall
+//        behind slow, low-priority reads.  Consecutive queued reads for the
+//        same device are sent together as one combined transfer.  If that
+//        transfer fails, each read is retried on its own, so registers that
+//        change when read (FIFO data, latched status) may be read twice.
+
+// Standard C/C++ headers
+#include <cassert>
+#include <memory>
+#include <algorithm>
+#include <string.h>
+
+// Local headers
+#include "twiQueue.h"
+
+TWIQueue::TWIQueue(TWIBus& bus, std::ostream& outStream) : bus(bus), outStream(outStream),
+	nextSequence(0), queueDepth(0), stopThread(false)
+{
+	workerThread = std::thread(&TWIQueue::WorkerThreadEntry, this);
+}
+
+TWIQueue::~TWIQueue()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopThread = true;
+	}
+
+	workAvailable.notify_all();
+	workerThread.join();
+
+	for (auto& queue : queues)
+	{
+		for (auto& entry : queue)
+		{
+			Result result;
+			result.ok = false;
+			result.expired = false;
+			Complete(entry.second, result);
+		}
+	}
+}
+
+std::future<TWIQueue::Result> TWIQueue::Submit(const Request& request)
+{
+	std::shared_ptr<std::promise<Result>> promise(std::make_shared<std::promise<Result>>());
+	std::future<Result> future(promise->get_future());
+	Submit(request, [promise](const Result& result)
+	{
+		promise->set_value(result);
+	});
+
+	return future;
+}
+
+void TWIQueue::Submit(const Request& request, Callback callback)
+{
+	assert(!request.writeData.empty() || request.readSize > 0);
+	assert(CountMessages(request) <= I2CBackend::maxTransferMessages);
+
+	// Would make the whole batch fail, not just this request
+	if (request.writeData.size() > I2CBackend::maxTransferSize ||
+		request.readSize > I2CBackend::maxTransferSize)
+	{
+		outStream << "Queued request exceeds the maximum transfer size ("
+			<< I2CBackend::maxTransferSize << " bytes)" << std::endl;
+		assert(false);
+
+		Pending pending;
+		pending.request = request;
+		pending.callback = std::move(callback);
+		pending.submitTime = Clock::now();
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			statistics.submitted++;
+		}
+
+		Result result;
+		result.ok = false;
+		result.expired = false;
+		Complete(pending, result);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		Pending& pending(queues[static_cast<int>(request.priority)][Key(request.deadline, nextSequence++)]);
+		pending.request = request;
+		pending.callback = std::move(callback);
+		pending.submitTime = Clock::now();
+
+		queueDepth++;
+		statistics.submitted++;
+		statistics.maxQueueDepth = std::max(statistics.maxQueueDepth, queueDepth);
+	}
+
+	workAvailable.notify_one();
+}
+
+size_t TWIQueue::GetQueueDepth() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return queueDepth;
+}
+
+TWIQueue::Statistics TWIQueue::GetStatistics() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return statistics;
+}
+
+void TWIQueue::ResetStatistics()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	statistics = Statistics();
+}
+
+void TWIQueue::WorkerThreadEntry()
+{
+	while (true)
+	{
+		std::vector<Pending> batch, expired;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			workAvailable.wait(lock, [this]()
+			{
+				return stopThread || queueDepth > 0;
+			});
+
+			if (stopThread)
+				return;
+
+			TakeBatch(batch, expired);
+		}
+
+		for (auto& pending : expired)
+		{
+			Result result;
+			result.ok = false;
+			result.expired = true;
+			Complete(pending, result);
+		}
+
+		if (batch.empty())
+			continue;// Everything we looked at had expired
+
+		std::vector<Result> results(batch.size());
+		const bool ok(TransferRequests(batch.data(), results.data(), batch.size()));
+
+		// A failed batch doesn't tell us which request failed, so try each
+		// one on its own.  Batches only contain reads, so nothing is written
+		// twice.
+		unsigned int i;
+		for (i = 0; i < batch.size(); i++)
+		{
+			if (ok)
+				results[i].ok = true;
+			else if (batch.size() > 1)
+				results[i].ok = TransferRequests(&batch[i], &results[i], 1);
+			else
+				results[i].ok = false;
+
+			Complete(batch[i], results[i]);
+		}
+	}
+}
+
+// Performs the requests as one combined transfer, filling in the read data
+bool TWIQueue::TransferRequests(Pending* requests, Result* results, const size_t& count)
+{
+	std::vector<I2CBackend::Message> messages;
+	messages.reserve(2 * count);
+
+	unsigned int i;
+	for (i = 0; i < count; i++)
+	{
+		Request& request(requests[i].request);
+		I2CBackend::Message message;
+		message.address = request.address;
+		if (!request.writeData.empty())
+		{
+			message.read = false;
+			message.data = request.writeData.data();
+			message.size = request.writeData.size();
+			messages.push_back(message);
+		}
+
+		results[i].expired = false;
+		results[i].readData.resize(request.readSize);
+		if (request.readSize > 0)
+		{
+			message.read = true;
+			message.data = results[i].readData.data();
+			message.size = request.readSize;
+			messages.push_back(message);
+		}
+	}
+
+	const bool ok(bus.Transfer(messages.data(), messages.size()));
+	if (!ok)
+		outStream << "Queued transfer to 0x" << std::hex << static_cast<unsigned int>(requests[0].request.address)
+			<< std::dec << (count > 1 ? " (batched)" : "") << " failed:  " << strerror(errno) << std::endl;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	statistics.transfers++;
+	return ok;
+}
+
+// Takes the next request, plus any that immediately follow it in the same
+// queue for the same device (as many as fit in one transfer), as long as all
+// of them are reads (possibly preceded by a write, e.g. of a register
+// address).  Requests that only write are always sent on their own, so that
+// a failed batch can be retried without repeating a write.  Expired requests
+// found along the way are removed too.  Caller must hold the lock.
+void TWIQueue::TakeBatch(std::vector<Pending>& batch, std::vector<Pending>& expired)
+{
+	const Clock::time_point now(Clock::now());
+	size_t messageCount(0);
+
+	for (auto& queue : queues)
+	{
+		auto it(queue.begin());
+		while (it != queue.end())
+		{
+			if (it->second.request.deadline < now)
+			{
+				expired.push_back(std::move(it->second));
+				it = queue.erase(it);
+				queueDepth--;
+				continue;
+			}
+
+			if (!batch.empty() && (it->second.request.address != batch.front().request.address ||
+				batch.front().request.readSize == 0 || it->second.request.readSize == 0 ||
+				messageCount + CountMessages(it->second.request) > I2CBackend::maxTransferMessages))
+				break;
+
+			messageCount += CountMessages(it->second.request);
+			batch.push_back(std::move(it->second));
+			it = queue.erase(it);
+			queueDepth--;
+		}
+
+		if (!batch.empty())
+			break;
+	}
+}
+
+void TWIQueue::Complete(Pending& pending, Result& result)
+{
+	result.latency = Clock::now() - pending.submitTime;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (result.expired)
+			statistics.expired++;
+		else if (result.ok)
+			statistics.completed++;
+		else
+			statistics.failed++;
+
+		statistics.totalLatency += result.latency;
+		statistics.maxLatency = std::max(statistics.maxLatency, result.latency);
+	}
+
+	if (pending.callback)
+		pending.callback(result);
+}
+
+size_t TWIQueue::CountMessages(const Request& request)
+{
+	return (request.writeData.empty() ? 0 : 1) + (request.readSize == 0 ? 0 : 1);
+}
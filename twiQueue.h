@@ -0,0 +1,120 @@
+// File:  twiQueue.h
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Desc:  Asynchronous transaction queue for a shared TWIBus.  A worker thread
+//        performs queued transactions in priority order (earliest deadline
+//        first within each priority), so that a control loop doesn't stall
+//        behind slow, low-priority reads.  Consecutive queued reads for the
+//        same device are sent together as one combined transfer.  If that
+//        transfer fails, each read is retried on its own, so registers that
+//        change when read (FIFO data, latched status) may be read twice.
+
+#ifndef TWI_QUEUE_H_
+#define TWI_QUEUE_H_
+
+// Standard C++ headers
+#include <array>
+#include <map>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <functional>
+#include <chrono>
+#include <iostream>
+#include <cstdint>
+
+// Local headers
+#include "twiBus.h"
+
+class TWIQueue
+{
+public:
+	TWIQueue(TWIBus& bus, std::ostream& outStream = std::cout);
+	~TWIQueue();// Waits for the current batch; requests still queued fail
+
+	typedef std::chrono::steady_clock Clock;
+
+	enum class Priority
+	{
+		High,
+		Normal,
+		Low
+	};
+
+	struct Request
+	{
+		unsigned char address;
+		std::vector<unsigned char> writeData;// Sent first, unless empty
+		unsigned short readSize = 0;// Then this many bytes are read, unless zero
+		Priority priority = Priority::Normal;
+
+		// Requests that haven't started by the deadline are dropped
+		Clock::time_point deadline = Clock::time_point::max();
+	};
+
+	struct Result
+	{
+		bool ok;
+		bool expired;// True if the request was dropped at its deadline
+		std::vector<unsigned char> readData;
+		Clock::duration latency;// From submission to completion
+	};
+
+	typedef std::function<void(const Result&)> Callback;
+
+	// Requests that write or read more than I2CBackend::maxTransferSize bytes
+	// fail immediately (the callback is then called from Submit)
+	std::future<Result> Submit(const Request& request);
+	void Submit(const Request& request, Callback callback);// Called from the worker thread
+
+	size_t GetQueueDepth() const;
+
+	struct Statistics
+	{
+		uint64_t submitted = 0;
+		uint64_t completed = 0;
+		uint64_t failed = 0;
+		uint64_t expired = 0;
+		uint64_t transfers = 0;// Each may contain several batched requests
+		size_t maxQueueDepth = 0;
+		Clock::duration totalLatency = Clock::duration::zero();
+		Clock::duration maxLatency = Clock::duration::zero();
+	};
+
+	Statistics GetStatistics() const;
+	void ResetStatistics();
+
+private:
+	TWIBus& bus;
+	std::ostream& outStream;
+
+	struct Pending
+	{
+		Request request;
+		Callback callback;
+		Clock::time_point submitTime;
+	};
+
+	// Ordered by deadline, then by submission order
+	typedef std::pair<Clock::time_point, uint64_t> Key;
+	std::array<std::map<Key, Pending>, 3> queues;// Indexed by priority
+	uint64_t nextSequence;
+	size_t queueDepth;
+
+	mutable std::mutex mutex;
+	std::condition_variable workAvailable;
+	bool stopThread;
+	Statistics statistics;
+
+	std::thread workerThread;
+
+	void WorkerThreadEntry();
+	void TakeBatch(std::vector<Pending>& batch, std::vector<Pending>& expired);
+	bool TransferRequests(Pending* requests, Result* results, const size_t& count);
+	void Complete(Pending& pending, Result& result);
+	static size_t CountMessages(const Request& request);
+};
+
+#endif// TWI_QUEUE_H_
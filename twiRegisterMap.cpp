@@ -0,0 +1,264 @@
+// File:  twiRegisterMap.cpp
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Desc:  Register-level access to a TWI device with 8-bit register addresses
+//        and an auto-incrementing register pointer.  Keeps shadow copies of
+//        registers declared as cached, so that reads (and read-modify-write
+//        updates) of configuration registers don't need the bus, and writes
+//        can be deferred and sent together as burst writes.
+
+// Standard C/C++ headers
+#include <cassert>
+#include <algorithm>
+
+// Local headers
+#include "twiRegisterMap.h"
+
+TWIRegisterMap::TWIRegisterMap(TWI& device, std::ostream& outStream) : device(device),
+	outStream(outStream), writeMode(WriteMode::WriteThrough), maxBurstLength(registerCount)
+{
+}
+
+void TWIRegisterMap::DeclareRegister(const unsigned char& reg, const Access& access)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	Register& r(registers[reg]);
+	r = Register();
+	r.access = access;
+}
+
+void TWIRegisterMap::DeclareRegister(const unsigned char& reg, const Access& access,
+	const unsigned char& defaultValue)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	Register& r(registers[reg]);
+	r = Register();
+	r.access = access;
+	r.hasDefault = true;
+	r.defaultValue = defaultValue;
+	if (access != Access::Volatile)
+	{
+		r.valid = true;
+		r.value = defaultValue;
+	}
+}
+
+void TWIRegisterMap::SetWriteMode(const WriteMode& mode)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	writeMode = mode;
+}
+
+void TWIRegisterMap::SetMaxBurstLength(const unsigned int& length)
+{
+	assert(length > 0);
+	std::lock_guard<std::mutex> lock(mutex);
+	maxBurstLength = length;
+}
+
+bool TWIRegisterMap::ReadRegister(const unsigned char& reg, unsigned char& value)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return Read(reg, value);
+}
+
+bool TWIRegisterMap::WriteRegister(const unsigned char& reg, const unsigned char& value)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return Write(reg, value);
+}
+
+bool TWIRegisterMap::UpdateBits(const unsigned char& reg, const unsigned char& mask,
+	const unsigned char& value)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	unsigned char oldValue;
+	if (!Read(reg, oldValue))
+		return false;
+
+	const unsigned char newValue((oldValue & ~mask) | (value & mask));
+	if (newValue == oldValue && registers[reg].access != Access::Volatile)
+		return true;
+
+	return Write(reg, newValue);
+}
+
+bool TWIRegisterMap::Flush()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return FlushLocked();
+}
+
+// Reads each run of consecutive cached registers with one burst
+bool TWIRegisterMap::Sync()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	unsigned char buffer[registerCount];
+	const unsigned int maxLength(std::min(static_cast<size_t>(maxBurstLength), device.GetMaxChunkSize()));
+	unsigned int start(0);
+	while (start < registerCount)
+	{
+		// Don't overwrite changes that haven't been flushed yet
+		if (registers[start].access != Access::Cached || registers[start].dirty)
+		{
+			start++;
+			continue;
+		}
+
+		unsigned int end(start + 1);
+		while (end < registerCount && end - start < maxLength &&
+			registers[end].access == Access::Cached && !registers[end].dirty)
+			end++;
+
+		const unsigned char reg(static_cast<unsigned char>(start));
+		if (!device.WriteRead(&reg, 1, buffer, end - start))
+		{
+			outStream << "Failed to sync registers " << start << " to " << end - 1 << std::endl;
+			return false;
+		}
+
+		unsigned int i;
+		for (i = start; i < end; i++)
+		{
+			registers[i].value = buffer[i - start];
+			registers[i].valid = true;
+			registers[i].confirmed = true;
+		}
+
+		start = end;
+	}
+
+	return true;
+}
+
+void TWIRegisterMap::Invalidate()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	for (auto& r : registers)
+	{
+		r.dirty = false;
+		r.confirmed = false;
+		r.valid = r.hasDefault && r.access != Access::Volatile;
+		r.value = r.defaultValue;
+	}
+}
+
+bool TWIRegisterMap::Read(const unsigned char& reg, unsigned char& value)
+{
+	Register& r(registers[reg]);
+	if (r.valid && r.access != Access::Volatile)
+	{
+		value = r.value;
+		return true;
+	}
+
+	if (r.access == Access::WriteOnly)
+	{
+		outStream << "Register " << static_cast<unsigned int>(reg)
+			<< " is write-only and hasn't been written" << std::endl;
+		return false;
+	}
+
+	if (!device.WriteRead(&reg, 1, &value, 1))
+		return false;
+
+	if (r.access == Access::Cached)
+	{
+		r.value = value;
+		r.valid = true;
+		r.confirmed = true;
+	}
+
+	return true;
+}
+
+bool TWIRegisterMap::Write(const unsigned char& reg, const unsigned char& value)
+{
+	Register& r(registers[reg]);
+	if (r.access == Access::Volatile)
+	{
+		const unsigned char data[2] = {reg, value};
+		return device.Write(data, sizeof(data));
+	}
+
+	if (r.valid && r.value == value && !r.dirty)
+		return true;// Already there
+
+	r.value = value;
+	r.valid = true;
+	r.dirty = true;
+
+	if (writeMode == WriteMode::Deferred)
+		return true;
+
+	return FlushLocked();
+}
+
+bool TWIRegisterMap::FlushLocked()
+{
+	// Each burst starts with the register address
+	const unsigned int maxLength(std::min(static_cast<size_t>(maxBurstLength), device.GetMaxChunkSize() - 1));
+
+	unsigned char buffer[registerCount + 1];
+	unsigned int start(0);
+	while (start < registerCount)
+	{
+		if (!registers[start].dirty)
+		{
+			start++;
+			continue;
+		}
+
+		if (maxLength == 0)
+		{
+			outStream << "Maximum chunk size is too small for register writes" << std::endl;
+			return false;
+		}
+
+		// Extend the burst through dirty registers, and through gaps of clean
+		// registers whose values we know, as long as another dirty register
+		// follows the gap
+		unsigned int end(start + 1);
+		unsigned int candidate(end);
+		while (candidate < registerCount && candidate - start < maxLength)
+		{
+			if (registers[candidate].dirty)
+				end = ++candidate;
+			else if (CanFillGap(candidate))
+				candidate++;
+			else
+				break;
+		}
+
+		buffer[0] = static_cast<unsigned char>(start);
+		unsigned int i;
+		for (i = start; i < end; i++)
+			buffer[i - start + 1] = registers[i].value;
+
+		if (!device.Write(buffer, end - start + 1))
+		{
+			outStream << "Failed to flush registers " << start << " to " << end - 1 << std::endl;
+			return false;
+		}
+
+		for (i = start; i < end; i++)
+		{
+			registers[i].dirty = false;
+			registers[i].confirmed = true;
+		}
+
+		start = end;
+	}
+
+	return true;
+}
+
+// Rewriting a register with its current value is harmless only if we're
+// certain what that value is.  A declared default may be wrong (or the device
+// may have been reset), and write-only registers often have side effects
+// when written (command or FIFO registers), so neither can fill a gap.
+bool TWIRegisterMap::CanFillGap(const unsigned int& reg) const
+{
+	return registers[reg].access == Access::Cached && registers[reg].valid && registers[reg].confirmed;
+}
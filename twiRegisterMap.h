@@ -0,0 +1,102 @@
+// File:  twiRegisterMap.h
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Desc:  Register-level access to a TWI device with 8-bit register addresses
+//        and an auto-incrementing register pointer.  Keeps shadow copies of
+//        registers declared as cached, so that reads (and read-modify-write
+//        updates) of configuration registers don't need the bus, and writes
+//        can be deferred and sent together as burst writes.
+
+#ifndef TWI_REGISTER_MAP_H_
+#define TWI_REGISTER_MAP_H_
+
+// Standard C++ headers
+#include <array>
+#include <mutex>
+#include <iostream>
+
+// Local headers
+#include "twi.h"
+
+class TWIRegisterMap
+{
+public:
+	TWIRegisterMap(TWI& device, std::ostream& outStream = std::cout);
+
+	enum class Access
+	{
+		Volatile,// Changed by the device - always read from the bus (the default)
+		Cached,// Only changed by us - read once, then served from the shadow copy
+		WriteOnly// Can't be read back - reads return the last value written (or the default)
+	};
+
+	// A known power-on default saves reading the register the first time
+	void DeclareRegister(const unsigned char& reg, const Access& access);
+	void DeclareRegister(const unsigned char& reg, const Access& access,
+		const unsigned char& defaultValue);
+
+	enum class WriteMode
+	{
+		WriteThrough,// Writes to cached registers are sent immediately (the default)
+		Deferred// Writes to cached registers are only sent by Flush
+	};
+
+	void SetWriteMode(const WriteMode& mode);
+
+	// Longest burst sent by Flush or read by Sync (e.g. an EEPROM page size).
+	// Bursts are also kept within the device's maximum chunk size (less the
+	// register address, for writes), since TWI would split a longer burst and
+	// the device would take the first byte of the second part for an address.
+	void SetMaxBurstLength(const unsigned int& length);
+
+	bool ReadRegister(const unsigned char& reg, unsigned char& value);
+	bool WriteRegister(const unsigned char& reg, const unsigned char& value);
+
+	// Read-modify-write of the bits in mask; nothing is written if they
+	// already have the requested values
+	bool UpdateBits(const unsigned char& reg, const unsigned char& mask, const unsigned char& value);
+
+	// Writes all changed cached registers.  Runs of consecutive registers are
+	// sent as one burst; short gaps between them are filled with unchanged
+	// cached values rather than starting a new burst.  Only cached registers
+	// whose values were read from the device or written to it can fill gaps
+	// (not declared defaults, and never write-only registers).
+	bool Flush();
+
+	// Re-reads all cached registers from the device, in bursts
+	bool Sync();
+
+	// Forgets all shadow copies (e.g. after resetting the device).  Unflushed
+	// writes are lost.
+	void Invalidate();
+
+private:
+	static const unsigned int registerCount = 256;
+
+	TWI& device;
+	std::ostream& outStream;
+
+	struct Register
+	{
+		Access access = Access::Volatile;
+		bool valid = false;// Shadow copy matches the device (or will, once flushed)
+		bool dirty = false;// Shadow copy hasn't been written to the device yet
+		bool confirmed = false;// Value was read from or written to the device (not just a default)
+		unsigned char value = 0;
+		bool hasDefault = false;
+		unsigned char defaultValue = 0;
+	};
+
+	std::mutex mutex;
+	std::array<Register, registerCount> registers;
+	WriteMode writeMode;
+	unsigned int maxBurstLength;
+
+	// Caller must hold the lock
+	bool Read(const unsigned char& reg, unsigned char& value);
+	bool Write(const unsigned char& reg, const unsigned char& value);
+	bool FlushLocked();
+	bool CanFillGap(const unsigned int& reg) const;
+};
+
+#endif// TWI_REGISTER_MAP_H_
@@ -0,0 +1,376 @@
+// File:  w1DeviceRegistry.cpp
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  Keeps an up-to-date list of the DS18B20 sensors on the 1-wire bus.
+//        A background thread rescans the device directory only when the
+//        kernel reports a 1-wire device being added or removed (or when
+//        inotify reports a change, for fake device trees), so callers can
+//        check for sensor swaps as often as they like.
+
+// Standard C++ headers
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+
+// *nix standard headers
+#include <unistd.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+
+// Local headers
+#include "w1DeviceRegistry.h"
+#include "ds18b20Sensor.h"
+
+//==========================================================================
+// Class:			W1DeviceRegistry
+// Function:		None
+//
+// Description:		Static and constant member initialization/definitions for
+//					W1DeviceRegistry class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+const std::chrono::milliseconds W1DeviceRegistry::fallbackPollPeriod(1000);
+
+//==========================================================================
+// Class:			W1DeviceRegistry
+// Function:		W1DeviceRegistry
+//
+// Description:		Constructor for W1DeviceRegistry class.  Loads the kernel
+//					modules, scans for sensors and starts watching for changes.
+//
+// Input Arguments:
+//		searchDirectory	= const std::string&
+//		pollPeriod		= const std::chrono::milliseconds&, zero to rely on
+//						  change notifications only
+//		outStream		= UString::OStream&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+W1DeviceRegistry::W1DeviceRegistry(const std::string& searchDirectory,
+	const std::chrono::milliseconds& pollPeriod, UString::OStream& outStream)
+	: searchDirectory(searchDirectory), pollPeriod(pollPeriod), outStream(outStream),
+	inotifyFileDescriptor(-1), ueventFileDescriptor(-1), stopThread(false), generation(0)
+{
+	DS18B20::LoadKernelModules(outStream);
+
+	wakeFileDescriptor = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (wakeFileDescriptor == -1)
+		outStream << "Failed to create wake descriptor:  " << strerror(errno) << std::endl;
+
+	// Open the notification sources before the first scan so that no change is missed
+	const bool inotifyOK(OpenInotify());
+	const bool ueventsOK(OpenUevents());
+	if (!inotifyOK && !ueventsOK && this->pollPeriod == std::chrono::milliseconds::zero())
+	{
+		outStream << "No change notifications available; polling for 1-wire devices" << std::endl;
+		this->pollPeriod = fallbackPollPeriod;
+	}
+
+	Rescan();
+
+	if (wakeFileDescriptor != -1)
+		watchThread = std::thread(&W1DeviceRegistry::WatchThreadEntry, this);
+}
+
+//==========================================================================
+// Class:			W1DeviceRegistry
+// Function:		~W1DeviceRegistry
+//
+// Description:		Destructor for W1DeviceRegistry class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+W1DeviceRegistry::~W1DeviceRegistry()
+{
+	if (watchThread.joinable())
+	{
+		stopThread = true;
+		const uint64_t wake(1);
+		if (write(wakeFileDescriptor, &wake, sizeof(wake)) != sizeof(wake))
+			outStream << "Failed to wake watch thread:  " << strerror(errno) << std::endl;
+		watchThread.join();
+	}
+
+	if (inotifyFileDescriptor != -1)
+		close(inotifyFileDescriptor);
+	if (ueventFileDescriptor != -1)
+		close(ueventFileDescriptor);
+	if (wakeFileDescriptor != -1)
+		close(wakeFileDescriptor);
+}
+
+//==========================================================================
+// Class:			W1DeviceRegistry
+// Function:		GetSensors
+//
+// Description:		Returns the current list of sensors.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::shared_ptr<const DeviceList>
+//
+//==========================================================================
+std::shared_ptr<const W1DeviceRegistry::DeviceList> W1DeviceRegistry::GetSensors() const
+{
+	return std::atomic_load(&sensors);
+}
+
+//==========================================================================
+// Class:			W1DeviceRegistry
+// Function:		Rescan
+//
+// Description:		Scans the device directory and publishes the new list if
+//					it has changed.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void W1DeviceRegistry::Rescan()
+{
+	std::lock_guard<std::mutex> lock(scanMutex);
+
+	std::shared_ptr<DeviceList> newSensors(std::make_shared<DeviceList>(
+		DS18B20::GetConnectedSensors(searchDirectory)));
+	std::sort(newSensors->begin(), newSensors->end());
+
+	const std::shared_ptr<const DeviceList> oldSensors(std::atomic_load(&sensors));
+	if (oldSensors && *oldSensors == *newSensors)
+		return;
+
+	std::atomic_store(&sensors, std::shared_ptr<const DeviceList>(newSensors));
+	generation.fetch_add(1, std::memory_order_release);
+}
+
+//==========================================================================
+// Class:			W1DeviceRegistry
+// Function:		OpenInotify
+//
+// Description:		Starts watching the device directory with inotify.  This
+//					works for ordinary directories, but sysfs doesn't report
+//					devices added by the kernel this way.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool W1DeviceRegistry::OpenInotify()
+{
+	inotifyFileDescriptor = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+	if (inotifyFileDescriptor == -1)
+		return false;
+
+	if (inotify_add_watch(inotifyFileDescriptor, searchDirectory.c_str(),
+		IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR) == -1)
+	{
+		close(inotifyFileDescriptor);
+		inotifyFileDescriptor = -1;
+		return false;
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			W1DeviceRegistry
+// Function:		OpenUevents
+//
+// Description:		Subscribes to the kernel's device add/remove events.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool W1DeviceRegistry::OpenUevents()
+{
+	ueventFileDescriptor = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK,
+		NETLINK_KOBJECT_UEVENT);
+	if (ueventFileDescriptor == -1)
+		return false;
+
+	sockaddr_nl address;
+	memset(&address, 0, sizeof(address));
+	address.nl_family = AF_NETLINK;
+	address.nl_groups = 1;// Kernel events (as opposed to events re-broadcast by udev)
+	if (bind(ueventFileDescriptor, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1)
+	{
+		close(ueventFileDescriptor);
+		ueventFileDescriptor = -1;
+		return false;
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			W1DeviceRegistry
+// Function:		WatchThreadEntry
+//
+// Description:		Entry point for the watch thread.  Rescans whenever a
+//					relevant change is reported, or at the poll period.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void W1DeviceRegistry::WatchThreadEntry()
+{
+	pollfd descriptors[3];
+	descriptors[0].fd = wakeFileDescriptor;
+	descriptors[1].fd = inotifyFileDescriptor;// Ignored by poll if -1
+	descriptors[2].fd = ueventFileDescriptor;
+
+	const int timeout(pollPeriod > std::chrono::milliseconds::zero() ? pollPeriod.count() : -1);
+	while (!stopThread)
+	{
+		unsigned int i;
+		for (i = 0; i < 3; i++)
+		{
+			descriptors[i].events = POLLIN;
+			descriptors[i].revents = 0;
+		}
+
+		const int result(poll(descriptors, 3, timeout));
+		if (result == -1)
+		{
+			if (errno == EINTR)
+				continue;
+
+			outStream << "Failed to wait for 1-wire device changes:  " << strerror(errno) << std::endl;
+			return;
+		}
+
+		if (stopThread)
+			return;
+
+		bool changed(result == 0);// Poll period elapsed
+		if ((descriptors[1].revents & POLLIN) && DrainInotify())
+			changed = true;
+		if ((descriptors[2].revents & POLLIN) && DrainUevents())
+			changed = true;
+
+		if (changed)
+			Rescan();
+	}
+}
+
+//==========================================================================
+// Class:			W1DeviceRegistry
+// Function:		DrainInotify
+//
+// Description:		Reads all pending inotify events.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if any events were read
+//
+//==========================================================================
+bool W1DeviceRegistry::DrainInotify()
+{
+	alignas(inotify_event) char buffer[4096];
+	bool any(false);
+	while (read(inotifyFileDescriptor, buffer, sizeof(buffer)) > 0)
+		any = true;
+
+	return any;
+}
+
+//==========================================================================
+// Class:			W1DeviceRegistry
+// Function:		DrainUevents
+//
+// Description:		Reads all pending uevents and checks for any from the
+//					1-wire subsystem.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true if any 1-wire devices were added or removed
+//
+//==========================================================================
+bool W1DeviceRegistry::DrainUevents()
+{
+	// Each message is a header line followed by NUL-separated KEY=value pairs
+	char buffer[4096];
+	const char subsystem[] = "SUBSYSTEM=w1";
+	bool any(false);
+	ssize_t size;
+	while (size = recv(ueventFileDescriptor, buffer, sizeof(buffer), 0), size > 0)
+	{
+		const char* field(buffer);
+		const char* end(buffer + size);
+		while (field < end)
+		{
+			const size_t length(strnlen(field, end - field));
+			if (length == sizeof(subsystem) - 1 && memcmp(field, subsystem, length) == 0)
+				any = true;
+			field += length + 1;
+		}
+	}
+
+	return any;
+}
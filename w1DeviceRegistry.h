@@ -0,0 +1,75 @@
+// File:  w1DeviceRegistry.h
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  Keeps an up-to-date list of the DS18B20 sensors on the 1-wire bus.
+//        A background thread rescans the device directory only when the
+//        kernel reports a 1-wire device being added or removed (or when
+//        inotify reports a change, for fake device trees), so callers can
+//        check for sensor swaps as often as they like.
+
+#ifndef W1_DEVICE_REGISTRY_H_
+#define W1_DEVICE_REGISTRY_H_
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+
+// Local headers
+#include "utilities/uString.h"
+
+class W1DeviceRegistry
+{
+public:
+	// If pollPeriod is non-zero, the directory is also rescanned at that
+	// period, for file systems where change notifications don't work
+	W1DeviceRegistry(const std::string& searchDirectory = "/sys/bus/w1/devices/",
+		const std::chrono::milliseconds& pollPeriod = std::chrono::milliseconds(0),
+		UString::OStream& outStream = Cout);
+	~W1DeviceRegistry();
+
+	typedef std::vector<std::string> DeviceList;
+
+	// Sorted IDs of the connected DS18B20 sensors.  Doesn't touch the file
+	// system - the list is maintained by the background thread.
+	std::shared_ptr<const DeviceList> GetSensors() const;
+
+	// Incremented each time the list changes
+	uint64_t GetGeneration() const { return generation.load(std::memory_order_acquire); }
+
+	// Rescans from the calling thread
+	void Rescan();
+
+private:
+	static const std::chrono::milliseconds fallbackPollPeriod;
+
+	const std::string searchDirectory;
+	std::chrono::milliseconds pollPeriod;
+	UString::OStream &outStream;
+
+	int inotifyFileDescriptor;
+	int ueventFileDescriptor;
+	int wakeFileDescriptor;
+
+	std::thread watchThread;
+	std::atomic<bool> stopThread;
+
+	std::mutex scanMutex;
+	std::shared_ptr<const DeviceList> sensors;// Accessed with std::atomic_load/store
+	std::atomic<uint64_t> generation;
+
+	bool OpenInotify();
+	bool OpenUevents();
+
+	void WatchThreadEntry();
+	bool DrainInotify();
+	bool DrainUevents();
+};
+
+#endif// W1_DEVICE_REGISTRY_H_
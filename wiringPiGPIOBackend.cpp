@@ -0,0 +1,318 @@
+// File:  wiringPiGPIOBackend.cpp
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  GPIO backend that forwards all pin access to the Wiring Pi library.
+
+// Standard C++ headers
+#include <cassert>
+#include <thread>
+
+// Wiring pi headers
+#include <wiringPi.h>
+
+// Local headers
+#include "wiringPiGPIOBackend.h"
+
+//==========================================================================
+// Class:			WiringPiGPIOBackend
+// Function:		None
+//
+// Description:		Static member initialization.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+std::atomic<Interrupt*> WiringPiGPIOBackend::interrupts[WiringPiGPIOBackend::maxPins];
+std::atomic<Interrupt::EdgeDirection> WiringPiGPIOBackend::edges[WiringPiGPIOBackend::maxPins];
+std::atomic<unsigned int> WiringPiGPIOBackend::dispatchCounts[WiringPiGPIOBackend::maxPins];
+thread_local int WiringPiGPIOBackend::dispatchingPin(-1);
+const std::array<WiringPiGPIOBackend::ServiceRoutine, WiringPiGPIOBackend::maxPins>
+	WiringPiGPIOBackend::serviceRoutines(MakeServiceRoutines(std::make_integer_sequence<int, maxPins>()));
+
+//==========================================================================
+// Class:			WiringPiGPIOBackend
+// Function:		WiringPiGPIOBackend
+//
+// Description:		Constructor for WiringPiGPIOBackend class.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+WiringPiGPIOBackend::WiringPiGPIOBackend()
+{
+	wiringPiSetup();
+}
+
+//==========================================================================
+// Class:			WiringPiGPIOBackend
+// Function:		SetDataDirection
+//
+// Description:		Sets the data direction for the pin.
+//
+// Input Arguments:
+//		pin			= const int&
+//		direction	= const GPIO::DataDirection&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void WiringPiGPIOBackend::SetDataDirection(const int &pin, const GPIO::DataDirection &direction)
+{
+	if (direction == GPIO::DataDirection::Input)
+		pinMode(pin, INPUT);
+	else if (direction == GPIO::DataDirection::Output)
+		pinMode(pin, OUTPUT);
+	else if (direction == GPIO::DataDirection::PWMOutput)
+		pinMode(pin, PWM_OUTPUT);
+	else
+		assert(false);
+}
+
+//==========================================================================
+// Class:			WiringPiGPIOBackend
+// Function:		SetPullUpDown
+//
+// Description:		Sets the state of the optional internal pull-up/pull-down resistors.
+//
+// Input Arguments:
+//		pin		= const int&
+//		state	= const GPIO::PullResistance&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void WiringPiGPIOBackend::SetPullUpDown(const int &pin, const GPIO::PullResistance &state)
+{
+	if (state == GPIO::PullResistance::Off)
+		pullUpDnControl(pin, PUD_OFF);
+	else if (state == GPIO::PullResistance::PullUp)
+		pullUpDnControl(pin, PUD_UP);
+	else if (state == GPIO::PullResistance::PullDown)
+		pullUpDnControl(pin, PUD_DOWN);
+	else
+		assert(false);
+}
+
+//==========================================================================
+// Class:			WiringPiGPIOBackend
+// Function:		SetOutput
+//
+// Description:		Sets the state of the output pin.
+//
+// Input Arguments:
+//		pin		= const int&
+//		high	= const bool&, true for high, false for low
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void WiringPiGPIOBackend::SetOutput(const int &pin, const bool &high)
+{
+	digitalWrite(pin, high ? 1 : 0);
+}
+
+//==========================================================================
+// Class:			WiringPiGPIOBackend
+// Function:		GetInput
+//
+// Description:		Reads the status of the input pin.
+//
+// Input Arguments:
+//		pin	= const int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for high, false otherwise
+//
+//==========================================================================
+bool WiringPiGPIOBackend::GetInput(const int &pin)
+{
+	return digitalRead(pin) == 1;
+}
+
+//==========================================================================
+// Class:			WiringPiGPIOBackend
+// Function:		AttachInterrupt
+//
+// Description:		Registers a service routine with Wiring Pi that forwards
+//					edges to the interrupt.  Wiring Pi calls it from a thread
+//					dedicated to the pin, so edge times are taken on wake-up
+//					rather than by the kernel.
+//
+// Input Arguments:
+//		interrupt	= Interrupt&
+//		edge		= const Interrupt::EdgeDirection&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool WiringPiGPIOBackend::AttachInterrupt(Interrupt &interrupt, const Interrupt::EdgeDirection &edge)
+{
+	int edgeFlag;
+	if (edge == Interrupt::EdgeDirection::Rising)
+		edgeFlag = INT_EDGE_RISING;
+	else if (edge == Interrupt::EdgeDirection::Falling)
+		edgeFlag = INT_EDGE_FALLING;
+	else if (edge == Interrupt::EdgeDirection::Both)
+		edgeFlag = INT_EDGE_BOTH;
+	else if (edge == Interrupt::EdgeDirection::Preconfigured)
+		edgeFlag = INT_EDGE_SETUP;
+	else
+	{
+		assert(false);
+		return false;
+	}
+
+	const int pin(interrupt.GetPin());
+	assert(pin >= 0 && pin < static_cast<int>(maxPins));
+
+	edges[pin] = edge;
+	interrupts[pin] = &interrupt;
+	if (wiringPiISR(pin, edgeFlag, serviceRoutines[pin]) != 0)
+	{
+		interrupts[pin] = nullptr;
+		return false;
+	}
+
+	return true;
+}
+
+//==========================================================================
+// Class:			WiringPiGPIOBackend
+// Function:		DetachInterrupt
+//
+// Description:		Stops forwarding edges to the interrupt.  Wiring Pi has no
+//					way to remove a service routine, so the routine remains
+//					registered but does nothing.  Waits for any call to the
+//					interrupt already in progress (unless called from that
+//					call), so the interrupt may be destroyed afterwards.
+//
+// Input Arguments:
+//		interrupt	= Interrupt&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void WiringPiGPIOBackend::DetachInterrupt(Interrupt &interrupt)
+{
+	const int pin(interrupt.GetPin());
+	if (pin < 0 || pin >= static_cast<int>(maxPins))
+	{
+		assert(false);
+		return;
+	}
+
+	Interrupt *expected(&interrupt);
+	if (!interrupts[pin].compare_exchange_strong(expected, nullptr))
+		return;
+
+	// A service routine that incremented its count before the exchange may
+	// still be using the interrupt; any that start later will see nullptr
+	if (dispatchingPin == pin)
+		return;
+
+	while (dispatchCounts[pin] > 0)
+		std::this_thread::yield();
+}
+
+//==========================================================================
+// Class:			WiringPiGPIOBackend
+// Function:		ForwardEdge
+//
+// Description:		Service routine registered with Wiring Pi for one pin.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+template <int pin>
+void WiringPiGPIOBackend::ForwardEdge()
+{
+	const Interrupt::Clock::time_point time(Interrupt::Clock::now());
+	dispatchCounts[pin]++;
+	Interrupt *interrupt(interrupts[pin]);
+	if (!interrupt)
+	{
+		dispatchCounts[pin]--;
+		return;
+	}
+
+	bool rising;
+	if (edges[pin] == Interrupt::EdgeDirection::Rising)
+		rising = true;
+	else if (edges[pin] == Interrupt::EdgeDirection::Falling)
+		rising = false;
+	else
+		rising = digitalRead(pin) == 1;
+
+	dispatchingPin = pin;
+	interrupt->HandleEdge(rising, time);
+	dispatchingPin = -1;
+	dispatchCounts[pin]--;
+}
+
+//==========================================================================
+// Class:			WiringPiGPIOBackend
+// Function:		MakeServiceRoutines
+//
+// Description:		Builds the table of per-pin service routines.
+//
+// Input Arguments:
+//		None (pin numbers are deduced from the integer sequence)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		std::array<ServiceRoutine, sizeof...(pins)>
+//
+//==========================================================================
+template <int... pins>
+std::array<WiringPiGPIOBackend::ServiceRoutine, sizeof...(pins)>
+	WiringPiGPIOBackend::MakeServiceRoutines(std::integer_sequence<int, pins...>)
+{
+	return {{&ForwardEdge<pins>...}};
+}
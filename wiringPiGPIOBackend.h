@@ -0,0 +1,51 @@
+// File:  wiringPiGPIOBackend.h
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  GPIO backend that forwards all pin access to the Wiring Pi library.
+
+#ifndef WIRING_PI_GPIO_BACKEND_H_
+#define WIRING_PI_GPIO_BACKEND_H_
+
+// Standard C++ headers
+#include <atomic>
+#include <array>
+#include <utility>
+
+// Local headers
+#include "gpioBackend.h"
+
+class WiringPiGPIOBackend : public GPIOBackend
+{
+public:
+	WiringPiGPIOBackend();
+
+	virtual void SetDataDirection(const int &pin, const GPIO::DataDirection &direction);
+	virtual void SetPullUpDown(const int &pin, const GPIO::PullResistance &state);
+	virtual void SetOutput(const int &pin, const bool &high);
+	virtual bool GetInput(const int &pin);
+
+	virtual bool AttachInterrupt(Interrupt &interrupt, const Interrupt::EdgeDirection &edge);
+	virtual void DetachInterrupt(Interrupt &interrupt);
+
+private:
+	// Wiring Pi service routines take no arguments, so each pin gets its own
+	// routine that forwards to the attached Interrupt object
+	static const unsigned int maxPins = 64;
+	typedef void (*ServiceRoutine)();
+	static const std::array<ServiceRoutine, maxPins> serviceRoutines;
+	static std::atomic<Interrupt*> interrupts[maxPins];
+	static std::atomic<Interrupt::EdgeDirection> edges[maxPins];
+
+	// Number of service routines running for each pin, so that detaching can
+	// wait for them before the Interrupt is destroyed
+	static std::atomic<unsigned int> dispatchCounts[maxPins];
+	static thread_local int dispatchingPin;// -1 unless this thread is in a service routine
+
+	template <int pin>
+	static void ForwardEdge();
+	template <int... pins>
+	static std::array<ServiceRoutine, sizeof...(pins)> MakeServiceRoutines(std::integer_sequence<int, pins...>);
+};
+
+#endif// WIRING_PI_GPIO_BACKEND_H_
@@ -0,0 +1,127 @@
+// File:  wiringPiPWMBackend.cpp
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  PWM backend that forwards all calls to the Wiring Pi library.
+
+// Standard C++ headers
+#include <cassert>
+
+// Wiring pi headers
+#include <wiringPi.h>
+
+// Local headers
+#include "wiringPiPWMBackend.h"
+
+//==========================================================================
+// Class:			WiringPiPWMBackend
+// Function:		WiringPiPWMBackend
+//
+// Description:		Constructor for WiringPiPWMBackend class.  Wiring Pi is
+//					initialized here too, in case the pins are handled by a
+//					different GPIO backend.
+//
+// Input Arguments:
+//		None
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+WiringPiPWMBackend::WiringPiPWMBackend()
+{
+	wiringPiSetup();
+}
+
+//==========================================================================
+// Class:			WiringPiPWMBackend
+// Function:		SetMode
+//
+// Description:		Sets the PWM mode.
+//
+// Input Arguments:
+//		mode	= const PWMOutput::PWMMode&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void WiringPiPWMBackend::SetMode(const PWMOutput::PWMMode &mode)
+{
+	if (mode == PWMOutput::PWMMode::Balanced)
+		pwmSetMode(PWM_MODE_BAL);
+	else if (mode == PWMOutput::PWMMode::MarkSpace)
+		pwmSetMode(PWM_MODE_MS);
+	else
+		assert(false);
+}
+
+//==========================================================================
+// Class:			WiringPiPWMBackend
+// Function:		SetRange
+//
+// Description:		Sets the PWM range.
+//
+// Input Arguments:
+//		range	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void WiringPiPWMBackend::SetRange(const unsigned int &range)
+{
+	pwmSetRange(range);
+}
+
+//==========================================================================
+// Class:			WiringPiPWMBackend
+// Function:		SetClockDivisor
+//
+// Description:		Sets the PWM clock divisor.
+//
+// Input Arguments:
+//		divisor	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void WiringPiPWMBackend::SetClockDivisor(const unsigned int &divisor)
+{
+	pwmSetClock(divisor);
+}
+
+//==========================================================================
+// Class:			WiringPiPWMBackend
+// Function:		Write
+//
+// Description:		Sets the PWM output value (on-time in counts of range).
+//
+// Input Arguments:
+//		pin		= const int&
+//		value	= const unsigned int&
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		None
+//
+//==========================================================================
+void WiringPiPWMBackend::Write(const int &pin, const unsigned int &value)
+{
+	pwmWrite(pin, value);
+}
@@ -0,0 +1,24 @@
+// File:  wiringPiPWMBackend.h
+// Date:  10/17/2026
+// Auth:  K. Loux
+// Copy:  (c) Copyright 2026
+// Desc:  PWM backend that forwards all calls to the Wiring Pi library.
+
+#ifndef WIRING_PI_PWM_BACKEND_H_
+#define WIRING_PI_PWM_BACKEND_H_
+
+// Local headers
+#include "pwmBackend.h"
+
+class WiringPiPWMBackend : public PWMBackend
+{
+public:
+	WiringPiPWMBackend();
+
+	virtual void SetMode(const PWMOutput::PWMMode &mode);
+	virtual void SetRange(const unsigned int &range);
+	virtual void SetClockDivisor(const unsigned int &divisor);
+	virtual void Write(const int &pin, const unsigned int &value);
+};
+
+#endif// WIRING_PI_PWM_BACKEND_H_